@@ -15,6 +15,9 @@ set -euo pipefail
 #   ./benchmark_c7i.sh --setup-isolation=c7i.xlarge        # Core isolation for c7i.xlarge
 #   ./benchmark_c7i.sh --fix-perf                          # Fix broken perf on newer AWS kernels
 #   ./benchmark_c7i.sh --repetitions=10                    # Custom repetition count
+#   ./benchmark_c7i.sh --cpu=3                             # Pin to CPU 3 instead of auto-placement
+#   ./benchmark_c7i.sh --strict                            # Refuse to run on a noisy configuration
+#   ./benchmark_c7i.sh --compare=benchmark_results_X.json  # A/B verdict against an earlier run
 # ──────────────────────────────────────────────────────────────────────
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
@@ -26,6 +29,9 @@ INSTANCE_SIZE=""
 FIX_PERF=false
 BENCHMARK_FILTER=""
 REPETITIONS=10
+BENCH_CPU=""
+STRICT=false
+COMPARE_JSON=""
 
 for arg in "$@"; do
     case "$arg" in
@@ -37,6 +43,9 @@ for arg in "$@"; do
         --fix-perf) FIX_PERF=true ;;
         --filter=*) BENCHMARK_FILTER="${arg#*=}" ;;
         --repetitions=*) REPETITIONS="${arg#*=}" ;;
+        --cpu=*) BENCH_CPU="${arg#*=}" ;;
+        --strict) STRICT=true ;;
+        --compare=*) COMPARE_JSON="${arg#*=}" ;;
     esac
 done
 
@@ -222,16 +231,44 @@ echo "================================================================"
 echo ""
 
 # ── 6. Run benchmarks ───────────────────────────────────────────────
+# llti_benchmarks pins itself: it reads /sys topology and picks an isolated,
+# non-CPU-0 core (no hwloc — see Orderbook/htop_hwloc_redlineRRM_story.md).
+# --cpu=N forces a specific CPU. The chosen CPU is printed as "llti_cpu".
+# toplev must count the core the benchmark runs on, so in the TMA modes the
+# binary's own choice is resolved up front and passed to both.
+if [ -z "$BENCH_CPU" ] && { $TOPDOWN_MODE || $TOPLEV_MODE; }; then
+    BENCH_CPU=$("${SCRIPT_DIR}/build/llti_benchmarks" --llti_print_cpu=1)
+fi
+PIN_ARGS=()
+if [ -n "$BENCH_CPU" ]; then
+    PIN_ARGS=(--llti_cpu="${BENCH_CPU}")
+fi
+# The binary also probes governor, turbo, THP, isolcpus/nohz_full and the
+# TSC rate on the CPU it runs on and records them as llti_* context lines
+# in the result file. --strict makes it exit instead of warning.
+if $STRICT; then
+    PIN_ARGS+=(--llti_strict=1)
+fi
+
 if ! $TOPDOWN_MODE && ! $TOPLEV_MODE; then
-    BENCHMARK_OUT="${SCRIPT_DIR}/benchmark_results_$(date +%Y%m%d_%H%M%S).txt"
-    BENCH_CMD=(taskset -c 1 "${SCRIPT_DIR}/build/llti_benchmarks"
-        --benchmark_repetitions="${REPETITIONS}")
+    RESULT_STEM="${SCRIPT_DIR}/benchmark_results_$(date +%Y%m%d_%H%M%S)"
+    BENCHMARK_OUT="${RESULT_STEM}.txt"
+    BENCHMARK_JSON="${RESULT_STEM}.json"
+    # The JSON keeps every repetition for tools/bench_compare.py.
+    BENCH_CMD=("${SCRIPT_DIR}/build/llti_benchmarks" ${PIN_ARGS[@]+"${PIN_ARGS[@]}"}
+        --benchmark_repetitions="${REPETITIONS}"
+        --benchmark_out="${BENCHMARK_JSON}" --benchmark_out_format=json)
     if [ -n "$BENCHMARK_FILTER" ]; then
         BENCH_CMD+=(--benchmark_filter="${BENCHMARK_FILTER}")
     fi
     "${BENCH_CMD[@]}" 2>&1 | tee "${BENCHMARK_OUT}"
     echo ""
-    echo "==> Results saved to ${BENCHMARK_OUT}"
+    echo "==> Results saved to ${BENCHMARK_OUT} (JSON: ${BENCHMARK_JSON})"
+    if [ -n "$COMPARE_JSON" ]; then
+        echo ""
+        echo "==> Comparing against ${COMPARE_JSON} (A = baseline, B = this run)..."
+        python3 "${SCRIPT_DIR}/tools/bench_compare.py" files "${COMPARE_JSON}" "${BENCHMARK_JSON}"
+    fi
 fi
 
 # ── 7. TMA: toplev.py (if --topdown or --toplev) ────────────────────
@@ -254,13 +291,19 @@ if $TOPDOWN_MODE || $TOPLEV_MODE; then
     fi
 
     TOPLEV_FILTER="${BENCHMARK_FILTER:-BM_EytzingerLookup_10M}"
+    # toplev names cores by socket and sysfs core_id, not by CPU number.
+    TOPLEV_CORE="S0-C0"
+    CPU_TOPO="/sys/devices/system/cpu/cpu${BENCH_CPU}/topology"
+    if [ "$BENCH_CPU" -ge 0 ] && [ -r "${CPU_TOPO}/core_id" ]; then
+        TOPLEV_CORE="S$(cat "${CPU_TOPO}/physical_package_id")-C$(cat "${CPU_TOPO}/core_id")"
+    fi
 
-    echo "==> Running toplev.py -l${TMA_LEVEL} (filter: ${TOPLEV_FILTER})..."
+    echo "==> Running toplev.py -l${TMA_LEVEL} on CPU ${BENCH_CPU} (${TOPLEV_CORE}, filter: ${TOPLEV_FILTER})..."
     TOPLEV_OUT="${SCRIPT_DIR}/toplev_results_$(date +%Y%m%d_%H%M%S).txt"
     sudo python3 "${PMU_TOOLS_DIR}/toplev.py" \
-        --force-cpu spr --core S0-C0 -l"${TMA_LEVEL}" -v --no-desc \
+        --force-cpu spr --core "${TOPLEV_CORE}" -l"${TMA_LEVEL}" -v --no-desc \
         --no-group --no-multiplex \
-        taskset -c 1 "${SCRIPT_DIR}/build/llti_benchmarks" \
+        "${SCRIPT_DIR}/build/llti_benchmarks" ${PIN_ARGS[@]+"${PIN_ARGS[@]}"} \
         --benchmark_filter="${TOPLEV_FILTER}" \
         --benchmark_repetitions=3 \
         2>&1 | tee "${TOPLEV_OUT}"
@@ -0,0 +1,92 @@
+#include "bench_common.h"
+#include "llti/arena.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/order_book.h"
+#include "llti/sorted_lookup.h"
+#include "llti/veb_lookup.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Default heap vs HugePageArena (llti/arena.h) for the same structures.
+//   arena=0  std::pmr default resource (malloc: 4 KB pages unless THP is
+//            "always")
+//   arena=1  HugePageArena with MADV_HUGEPAGE
+// Build time includes the page faults of the fresh table arrays, which is
+// where huge pages save the most (one fault per 2 MB). Lookups use 64K
+// random keys so the path spreads over enough pages to stress the STLB.
+
+namespace {
+
+constexpr size_t kArenaBytes = size_t{1} << 30;
+
+std::unique_ptr<llti::HugePageArena> make_arena(bool use) {
+    return use ? std::make_unique<llti::HugePageArena>(kArenaBytes) : nullptr;
+}
+
+std::pmr::memory_resource* resource(const std::unique_ptr<llti::HugePageArena>& arena) {
+    return arena ? arena.get() : std::pmr::get_default_resource();
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_ArenaBuild(benchmark::State& state) {
+    auto entries = make_entries(kLookupN);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto copy = entries;
+        state.ResumeTiming();
+        auto arena = make_arena(state.range(0));
+        Table table(resource(arena));
+        table.build(std::move(copy));
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * kLookupN);
+}
+BENCHMARK_TEMPLATE(BM_ArenaBuild, llti::SortedLookup<int64_t>)->ArgName("arena")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaBuild, llti::EytzingerLookup<int64_t>)->ArgName("arena")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaBuild, llti::VebLookup<int64_t>)->ArgName("arena")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+template <class Table>
+static void BM_ArenaLookup(benchmark::State& state) {
+    auto arena = make_arena(state.range(0));
+    Table table(resource(arena));
+    auto entries = make_entries(kLookupN);
+    constexpr size_t BATCH = 1 << 16;
+    std::mt19937_64 rng(99);
+    std::vector<int64_t> lookup_keys(BATCH);
+    for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+    table.build(std::move(entries));
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(lookup_keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    if (arena) state.counters["arena_mb"] = static_cast<double>(arena->used() >> 20);
+}
+BENCHMARK_TEMPLATE(BM_ArenaLookup, llti::SortedLookup<int64_t>)->ArgName("arena")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_ArenaLookup, llti::EytzingerLookup<int64_t>)->ArgName("arena")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_ArenaLookup, llti::VebLookup<int64_t>)->ArgName("arena")->Arg(0)->Arg(1);
+
+// The book's id map (32 MB) and price levels move into the arena; the
+// inline order pool stays wherever the book object lives.
+static void BM_ArenaOrderBook(benchmark::State& state) {
+    static const std::vector<BookOp> ops = make_book_ops(2'000'000);
+    auto arena = make_arena(state.range(0));
+    auto book = std::make_unique<llti::OrderBook>(kBookMinTick, kBookMaxTick, resource(arena));
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        apply_op(*book, ops[idx]);
+        benchmark::ClobberMemory();
+        if (++idx == ops.size()) idx = 0;
+    }
+}
+BENCHMARK(BM_ArenaOrderBook)->ArgName("arena")->Arg(0)->Arg(1);
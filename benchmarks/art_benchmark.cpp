@@ -0,0 +1,202 @@
+#include "bench_common.h"
+#include "llti/art_map.h"
+#include "llti/order_book.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Dynamic int64 -> uint32 maps under order-book-style traffic: ArtMap
+// against std::map, std::unordered_map and the order book's OrderMap.
+//
+// Every row holds kLive = 256K live keys. `keys` picks the key shape:
+//   0  order IDs: consecutive, each new key one past the last
+//   1  uniform random 64-bit keys
+// BM_MapInsert fills an empty map with kLive keys; BM_MapFind looks up
+// random live keys; BM_MapChurn erases a random live key and inserts a
+// new one, the steady state of an order book; BM_MapScan visits the ~100
+// keys following a random live key, which only the ordered maps support.
+//
+// OrderMap reserves space for 1M orders up front and leaves a tombstone
+// per erase, so BM_MapChurn runs a fixed 1M operations: enough for the
+// tombstones to lengthen its probes, not enough to fill the table.
+
+namespace {
+
+constexpr size_t BATCH = 1 << 16;
+constexpr int64_t kLive = 1 << 18;
+constexpr int64_t kScanKeys = 100;
+
+struct ArtAdapter {
+    llti::ArtMap<uint32_t> map;
+    void insert(int64_t k, uint32_t v) { map.insert(k, v); }
+    const uint32_t* find(int64_t k) const { return map.find(k); }
+    void erase(int64_t k) { map.erase(k); }
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn&& fn) const { map.scan(lo, hi, fn); }
+};
+
+struct StdMapAdapter {
+    std::map<int64_t, uint32_t> map;
+    void insert(int64_t k, uint32_t v) { map.insert_or_assign(k, v); }
+    const uint32_t* find(int64_t k) const {
+        auto it = map.find(k);
+        return it != map.end() ? &it->second : nullptr;
+    }
+    void erase(int64_t k) { map.erase(k); }
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn&& fn) const {
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first <= hi; ++it)
+            fn(it->first, it->second);
+    }
+};
+
+struct UnorderedMapAdapter {
+    std::unordered_map<int64_t, uint32_t> map;
+    void insert(int64_t k, uint32_t v) { map.insert_or_assign(k, v); }
+    const uint32_t* find(int64_t k) const {
+        auto it = map.find(k);
+        return it != map.end() ? &it->second : nullptr;
+    }
+    void erase(int64_t k) { map.erase(k); }
+};
+
+// Keys 0 and ~0 are OrderMap's markers; neither key shape produces them
+// in practice (order IDs start at 1).
+struct OrderMapAdapter {
+    llti::OrderMap map;
+    void insert(int64_t k, uint32_t v) { map.insert(static_cast<uint64_t>(k), v); }
+    const uint32_t* find(int64_t k) { return map.find(static_cast<uint64_t>(k)); }
+    void erase(int64_t k) { map.erase(static_cast<uint64_t>(k)); }
+};
+
+// Successive new keys of one shape.
+class KeySource {
+public:
+    explicit KeySource(int64_t shape) : random_(shape == 1) {}
+    int64_t next() { return random_ ? static_cast<int64_t>(rng_() | 1) : ++last_id_; }
+
+private:
+    bool random_;
+    std::mt19937_64 rng_{42};
+    int64_t last_id_ = 0;
+};
+
+// A map holding kLive keys, with those keys in insertion order.
+template <class Map>
+struct Filled {
+    std::unique_ptr<Map> map = std::make_unique<Map>();
+    std::vector<int64_t> live;
+    KeySource source;
+
+    explicit Filled(int64_t shape) : source(shape) {
+        live.reserve(kLive);
+        for (int64_t i = 0; i < kLive; ++i) {
+            live.push_back(source.next());
+            map->insert(live.back(), static_cast<uint32_t>(i));
+        }
+    }
+};
+
+std::vector<size_t> random_positions() {
+    std::mt19937_64 rng(99);
+    std::vector<size_t> pos(BATCH);
+    for (auto& p : pos) p = rng() % kLive;
+    return pos;
+}
+
+}  // namespace
+
+template <class Map>
+static void BM_MapInsert(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto map = std::make_unique<Map>();
+        KeySource source(state.range(0));
+        state.ResumeTiming();
+        for (int64_t i = 0; i < kLive; ++i) map->insert(source.next(), static_cast<uint32_t>(i));
+        benchmark::DoNotOptimize(map.get());
+        state.PauseTiming();
+        map.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kLive);
+}
+
+template <class Map>
+static void BM_MapFind(benchmark::State& state) {
+    Filled<Map> filled(state.range(0));
+    std::vector<int64_t> keys;
+    for (size_t p : random_positions()) keys.push_back(filled.live[p]);
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = filled.map->find(keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+
+template <class Map>
+static void BM_MapChurn(benchmark::State& state) {
+    Filled<Map> filled(state.range(0));
+    auto positions = random_positions();
+    size_t idx = 0;
+    uint32_t value = 0;
+    for (auto _ : state) {
+        int64_t& slot = filled.live[positions[idx]];
+        filled.map->erase(slot);
+        slot = filled.source.next();
+        filled.map->insert(slot, ++value);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+
+template <class Map>
+static void BM_MapScan(benchmark::State& state) {
+    Filled<Map> filled(state.range(0));
+    // Wide enough to hold ~kScanKeys keys of either shape.
+    const int64_t span = state.range(0) == 1
+                             ? static_cast<int64_t>(UINT64_MAX / kLive * kScanKeys)
+                             : kScanKeys - 1;
+    std::vector<int64_t> starts;
+    for (size_t p : random_positions()) starts.push_back(filled.live[p]);
+    size_t idx = 0;
+    int64_t visited = 0;
+    for (auto _ : state) {
+        int64_t lo = starts[idx];
+        int64_t hi = lo > INT64_MAX - span ? INT64_MAX : lo + span;
+        filled.map->scan(lo, hi, [&](int64_t, const uint32_t& v) {
+            benchmark::DoNotOptimize(v);
+            ++visited;
+        });
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    state.counters["keys_per_scan"] =
+        static_cast<double>(visited) / static_cast<double>(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_MapInsert, ArtAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapInsert, StdMapAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapInsert, UnorderedMapAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapInsert, OrderMapAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapFind, ArtAdapter)->ArgName("keys")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_MapFind, StdMapAdapter)->ArgName("keys")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_MapFind, UnorderedMapAdapter)->ArgName("keys")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_MapFind, OrderMapAdapter)->ArgName("keys")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_MapChurn, ArtAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Iterations(1 << 20);
+BENCHMARK_TEMPLATE(BM_MapChurn, StdMapAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Iterations(1 << 20);
+BENCHMARK_TEMPLATE(BM_MapChurn, UnorderedMapAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Iterations(1 << 20);
+BENCHMARK_TEMPLATE(BM_MapChurn, OrderMapAdapter)->ArgName("keys")->Arg(0)->Arg(1)
+    ->Iterations(1 << 20);
+BENCHMARK_TEMPLATE(BM_MapScan, ArtAdapter)->ArgName("keys")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_MapScan, StdMapAdapter)->ArgName("keys")->Arg(0)->Arg(1);
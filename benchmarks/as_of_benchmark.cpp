@@ -0,0 +1,142 @@
+#include "bench_common.h"
+#include "llti/as_of_lookup.h"
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+// As-of lookups over versioned keys: n keys, each with a uniform 1..max
+// versions at random timestamps in [0, kTimeSpan). Queries pick a random
+// stored key and a random time, so most land between two versions. The
+// naive reference is a std::map from key to a time-sorted vector of
+// (time, value), searched with upper_bound: a pointer chase down the map
+// followed by a binary search in a separately allocated vector.
+//
+// 10M keys x 50 versions needs ~10 GB and is skipped on smaller hosts.
+
+namespace {
+
+constexpr int64_t kTimeSpan = 1'000'000;
+constexpr size_t BATCH = 1 << 16;
+
+using AsOf = llti::AsOfLookup<int64_t>;
+using NaiveMap = std::map<int64_t, std::vector<std::pair<int64_t, int64_t>>>;
+
+// Calls fn(key, time, value) for every version of the (n, max_versions) data set.
+template <class Fn>
+void for_each_version(int64_t n, int64_t max_versions, Fn fn) {
+    auto entries = make_entries(n);
+    std::mt19937_64 rng(7);
+    for (const auto& e : entries) {
+        int64_t count = 1 + static_cast<int64_t>(rng() % max_versions);
+        for (int64_t v = 0; v < count; ++v)
+            fn(e.first, static_cast<int64_t>(rng() % kTimeSpan), static_cast<int64_t>(rng()));
+    }
+}
+
+// Peak build footprint: AsOfLookup holds the 24-byte input versions next to
+// its 16-byte copies; the map pays a node and a vector header per key.
+bool fits_in_ram(int64_t n, int64_t max_versions) {
+    size_t versions = static_cast<size_t>(n) * (max_versions + 1) / 2;
+    return versions * 40 + static_cast<size_t>(n) * 96 <= physical_ram_bytes() / 2;
+}
+
+// One table alive at a time, shared by both benchmarks: a 10M x 50 table
+// of either kind must not stay resident while the other kind is built.
+std::shared_ptr<void> current_table;
+const void* current_tag = nullptr;
+std::pair<int64_t, int64_t> current_args{-1, -1};
+
+// Returns the table for this row, calling build() only when the row changes.
+template <class Table, class Build>
+const Table& cached_table(int64_t n, int64_t max_versions, Build build) {
+    static const char tag = 0;
+    if (current_tag != &tag || current_args != std::make_pair(n, max_versions)) {
+        current_table.reset();
+        current_table = build();
+        current_tag = &tag;
+        current_args = {n, max_versions};
+    }
+    return *static_cast<const Table*>(current_table.get());
+}
+
+std::vector<std::pair<int64_t, int64_t>> make_queries(int64_t n) {
+    auto entries = make_entries(n);
+    std::mt19937_64 rng(99);
+    std::vector<std::pair<int64_t, int64_t>> queries(BATCH);
+    for (auto& q : queries)
+        q = {entries[rng() % entries.size()].first, static_cast<int64_t>(rng() % kTimeSpan)};
+    return queries;
+}
+
+void as_of_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"keys", "max_versions"});
+    b->Args({10'000'000, 1});
+    b->Args({10'000'000, 8});
+    b->Args({10'000'000, 50});
+    b->Args({1'000'000, 50});
+    b->Unit(benchmark::kNanosecond);
+}
+
+}  // namespace
+
+static void BM_AsOfLookup(benchmark::State& state) {
+    int64_t n = state.range(0), max_versions = state.range(1);
+    if (!fits_in_ram(n, max_versions)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    // Built once per row; benchmark calls the function again for each run.
+    const AsOf& table = cached_table<AsOf>(n, max_versions, [&] {
+        std::vector<AsOf::Version> versions;
+        for_each_version(n, max_versions,
+                         [&](int64_t k, int64_t t, int64_t v) { versions.push_back({k, t, v}); });
+        auto built = std::make_shared<AsOf>();
+        built->build(std::move(versions));
+        return built;
+    });
+    auto queries = make_queries(n);
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(queries[idx].first, queries[idx].second);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    state.counters["versions"] = static_cast<double>(table.num_versions());
+}
+BENCHMARK(BM_AsOfLookup)->Apply(as_of_args);
+
+static void BM_AsOfNaiveMap(benchmark::State& state) {
+    int64_t n = state.range(0), max_versions = state.range(1);
+    if (!fits_in_ram(n, max_versions)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    const NaiveMap& table = cached_table<NaiveMap>(n, max_versions, [&] {
+        auto built = std::make_shared<NaiveMap>();
+        for_each_version(n, max_versions,
+                         [&](int64_t k, int64_t t, int64_t v) { (*built)[k].push_back({t, v}); });
+        for (auto& [key, history] : *built)
+            std::stable_sort(history.begin(), history.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
+        return built;
+    });
+    auto queries = make_queries(n);
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        const int64_t* val = nullptr;
+        auto it = table.find(queries[idx].first);
+        if (it != table.end()) {
+            const auto& history = it->second;
+            auto pos = std::upper_bound(history.begin(), history.end(), queries[idx].second,
+                                        [](int64_t t, const auto& v) { return t < v.first; });
+            if (pos != history.begin()) val = &std::prev(pos)->second;
+        }
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+BENCHMARK(BM_AsOfNaiveMap)->Apply(as_of_args);
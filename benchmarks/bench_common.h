@@ -0,0 +1,150 @@
+#pragma once
+#include "llti/calibration.h"
+#include "llti/order_book.h"
+#include "llti/tsc.h"
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Shared helpers for the benchmark translation units.
+
+// Host memory calibration, measured once in benchmark_main.cpp before any
+// benchmark runs. Empty curve when disabled with --llti_calibrate=off.
+const llti::MemoryCalibration& host_calibration();
+
+// TSC ticks per second, measured once in benchmark_main.cpp.
+double host_tsc_hz();
+
+// Physical RAM of the host; rows that would not fit skip themselves.
+inline size_t physical_ram_bytes() {
+    return static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGE_SIZE);
+}
+
+// Random key-value pairs with uniform 64-bit keys (value == key).
+inline std::vector<std::pair<int64_t, int64_t>> make_entries(int64_t n, uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    entries.reserve(n);
+    for (int64_t i = 0; i < n; ++i) {
+        int64_t key = static_cast<int64_t>(rng());
+        entries.push_back({key, key});
+    }
+    return entries;
+}
+
+constexpr int64_t kLookupN = 10'000'000;
+
+// One kLookupN-entry table per layout, built from make_entries(kLookupN) on
+// first use and shared by every benchmark that times a single lookup.
+template <class Table>
+const Table& shared_table() {
+    static const Table table = [] {
+        Table t;
+        t.build(make_entries(kLookupN));
+        return t;
+    }();
+    return table;
+}
+
+// Per-operation latency samples in TSC ticks, kept in a ring so long runs
+// report the most recent 1M operations without growing. Timing each
+// operation with rdtsc adds ~20 cycles of overhead to every sample; compare
+// percentiles between variants, not against the plain Time column.
+class LatencyRecorder {
+public:
+    static constexpr size_t kCapacity = size_t{1} << 20;
+
+    LatencyRecorder() : samples_(kCapacity) {}
+
+    void record(uint64_t ticks) {
+        samples_[count_ & (kCapacity - 1)] = ticks;
+        ++count_;
+    }
+
+    // Adds <prefix>p50_ns / p99_ns / p999_ns / max_ns counters.
+    void report(benchmark::State& state, const std::string& prefix = "") {
+        size_t n = std::min(count_, kCapacity);
+        if (n == 0) return;
+        std::sort(samples_.begin(), samples_.begin() + n);
+        const double ns_per_tick = 1e9 / host_tsc_hz();
+        auto pct = [&](double p) {
+            size_t i = std::min(n - 1, static_cast<size_t>(p * n));
+            return samples_[i] * ns_per_tick;
+        };
+        state.counters[prefix + "p50_ns"] = pct(0.50);
+        state.counters[prefix + "p99_ns"] = pct(0.99);
+        state.counters[prefix + "p999_ns"] = pct(0.999);
+        state.counters[prefix + "max_ns"] = samples_[n - 1] * ns_per_tick;
+    }
+
+private:
+    std::vector<uint64_t> samples_;
+    size_t count_ = 0;
+};
+
+// --- Order book message streams ---
+
+constexpr llti::PriceTick kBookMinTick = 10'000;
+constexpr llti::PriceTick kBookMaxTick = 15'000;
+
+struct BookOp {
+    enum Kind : uint8_t { Add, Cancel, Modify };
+    Kind kind;
+    int32_t quantity;
+    uint64_t order_id;
+    llti::PriceTick price;
+};
+
+// A closed add/cancel/modify stream: ramps up to ~live_target resting
+// orders, churns, and ends by cancelling everything still live, so the same
+// stream can be replayed on one book indefinitely. Prices cluster around
+// mid (normal, sd 200 ticks) like a real book.
+inline std::vector<BookOp> make_book_ops(size_t churn_ops, size_t live_target = 100'000,
+                                         uint64_t seed = 7) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> price_dist((kBookMinTick + kBookMaxTick) / 2.0, 200.0);
+    auto price = [&] {
+        auto p = static_cast<llti::PriceTick>(price_dist(rng));
+        return std::clamp(p, kBookMinTick, kBookMaxTick);
+    };
+
+    std::vector<BookOp> ops;
+    ops.reserve(churn_ops + 2 * live_target);
+    std::vector<uint64_t> live;
+    uint64_t next_id = 1;
+    auto add = [&] {
+        ops.push_back({BookOp::Add, static_cast<int32_t>(rng() % 1000 + 1), next_id, price()});
+        live.push_back(next_id++);
+    };
+
+    while (live.size() < live_target) add();
+    for (size_t i = 0; i < churn_ops; ++i) {
+        uint64_t r = rng() % 100;
+        if (r < 45 || live.empty()) {
+            add();
+        } else if (r < 90) {
+            size_t j = rng() % live.size();
+            ops.push_back({BookOp::Cancel, 0, live[j], 0});
+            live[j] = live.back();
+            live.pop_back();
+        } else {
+            ops.push_back({BookOp::Modify, static_cast<int32_t>(rng() % 1000 + 1),
+                           live[rng() % live.size()], price()});
+        }
+    }
+    for (uint64_t id : live) ops.push_back({BookOp::Cancel, 0, id, 0});
+    return ops;
+}
+
+inline void apply_op(llti::OrderBook& book, const BookOp& op) {
+    switch (op.kind) {
+        case BookOp::Add: book.add_order(op.order_id, op.price, op.quantity); break;
+        case BookOp::Cancel: book.cancel_order(op.order_id); break;
+        case BookOp::Modify: book.modify_order(op.order_id, op.price, op.quantity); break;
+    }
+}
@@ -0,0 +1,157 @@
+#include "bench_common.h"
+#include "llti/calibration.h"
+#include "llti/environment.h"
+#include "llti/probe.h"
+#include "llti/topology.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Replaces benchmark::benchmark_main so the binary places itself.
+//
+// By default the benchmark thread is pinned to the best single core from
+// sysfs topology discovery (isolated, not CPU 0). Override with
+// --llti_cpu=N, or --llti_cpu=-1 to leave affinity untouched (e.g. when an
+// external wrapper such as taskset or toplev already pinned us).
+// --llti_print_cpu=1 prints the CPU that would be chosen and exits, so a
+// wrapper script can point its own tools at the same core.
+//
+// After pinning, the run environment (CPU model, governor, turbo, THP,
+// isolation of the CPU we landed on, measured TSC rate) is probed and
+// attached to the output as benchmark context. Noisy configurations print
+// a warning; --llti_strict=1 turns the warnings into a refusal to run.
+//
+// Finally the memory hierarchy is calibrated (pointer chase, TLB reach,
+// bandwidth — see llti/calibration.h) and summarised as llti_mem_*
+// context, so lookup numbers can be read against this host's latencies.
+// --llti_calibrate=quick (default) stops at max(4x L3, 64 MB) capped at
+// 1 GB; =full goes to 4 GB (at most half of RAM) and prints the curve;
+// =off skips it.
+//
+// Built with -DLLTI_ENABLE_PROBES=ON, the probe rings are dumped after the
+// run to --llti_probe_out (default llti_probes.txt) for
+// tools/probe_report.cpp.
+//
+// The LTO/PGO variants (LLTI_OPTIMIZED_VARIANTS) record which build they
+// are as llti_build, so their JSON results can be told apart.
+
+#ifndef LLTI_BUILD_VARIANT
+#define LLTI_BUILD_VARIANT "default"
+#endif
+
+static llti::MemoryCalibration g_calibration;
+static double g_tsc_hz = 0.0;
+
+const llti::MemoryCalibration& host_calibration() { return g_calibration; }
+double host_tsc_hz() { return g_tsc_hz; }
+
+static std::string fmt(double v, const char* spec = "%.1f") {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), spec, v);
+    return buf;
+}
+
+static void calibrate(const llti::Topology& topo, const std::string& mode) {
+    if (mode == "off") return;
+    const bool full = mode == "full";
+    size_t l3 = topo.l3_bytes ? topo.l3_bytes : size_t{32} << 20;
+    size_t max_bytes = full ? size_t{4} << 30
+                            : std::min(std::max(4 * l3, size_t{64} << 20), size_t{1} << 30);
+    max_bytes = std::min(max_bytes, physical_ram_bytes() / 2);
+
+    g_calibration = llti::MemoryCalibration::run(topo, max_bytes,
+                                                 full ? size_t{1} << 21 : size_t{1} << 19);
+    const auto& cal = g_calibration;
+    benchmark::AddCustomContext("llti_mem_l1_ns", fmt(cal.l1_ns));
+    benchmark::AddCustomContext("llti_mem_l2_ns", fmt(cal.l2_ns));
+    benchmark::AddCustomContext("llti_mem_l3_ns", fmt(cal.l3_ns));
+    benchmark::AddCustomContext("llti_mem_dram_ns", fmt(cal.dram_ns));
+    benchmark::AddCustomContext("llti_mem_dram_4k_ns", fmt(cal.dram_4k_ns));
+    benchmark::AddCustomContext("llti_mem_tlb_reach_kb", std::to_string(cal.tlb_reach_bytes >> 10));
+    benchmark::AddCustomContext("llti_mem_read_gbs", fmt(cal.bandwidth.read_gbs));
+    benchmark::AddCustomContext("llti_mem_write_gbs", fmt(cal.bandwidth.write_gbs));
+
+    if (full) {
+        std::fprintf(stderr, "llti: pointer-chase latency curve\n%14s %10s %10s\n",
+                     "bytes", "4k ns", "thp ns");
+        for (const auto& pt : cal.curve)
+            std::fprintf(stderr, "%14zu %10.1f %10.1f\n", pt.bytes, pt.ns_4k, pt.ns_huge);
+    }
+}
+
+// Remove "--<name>=<value>" from argv and return the value, or "" if absent.
+static std::string take_flag(int& argc, char** argv, const char* name) {
+    const std::string prefix = std::string("--") + name + "=";
+    std::string value;
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+            value = argv[i] + prefix.size();
+        } else {
+            argv[out++] = argv[i];
+        }
+    }
+    argc = out;
+    return value;
+}
+
+int main(int argc, char** argv) {
+    std::string cpu_flag = take_flag(argc, argv, "llti_cpu");
+    bool strict = take_flag(argc, argv, "llti_strict") == "1";
+    std::string calibrate_mode = take_flag(argc, argv, "llti_calibrate");
+    std::string probe_out = take_flag(argc, argv, "llti_probe_out");
+    bool print_cpu = take_flag(argc, argv, "llti_print_cpu") == "1";
+
+    auto topo = llti::Topology::discover();
+    int cpu = -1;
+    if (!cpu_flag.empty()) {
+        cpu = std::atoi(cpu_flag.c_str());
+    } else {
+        auto picked = topo.place(1);
+        if (!picked.empty()) cpu = picked.front();
+    }
+    if (print_cpu) {
+        std::printf("%d\n", cpu);
+        return 0;
+    }
+
+    if (cpu >= 0 && !llti::pin_current_thread(cpu))
+        std::fprintf(stderr, "llti: could not pin to CPU %d, running unpinned\n", cpu);
+    // Judge by the effective mask so external pinning (--llti_cpu=-1) counts.
+    bool pinned = llti::current_affinity().size() == 1;
+
+    auto env = llti::BenchEnvironment::probe(topo);
+    g_tsc_hz = env.tsc_hz;
+    for (const auto& [key, value] : env.context())
+        benchmark::AddCustomContext(key, value);
+    benchmark::AddCustomContext("llti_pinned", pinned ? "yes" : "no");
+    benchmark::AddCustomContext("llti_build", LLTI_BUILD_VARIANT);
+
+    auto warnings = env.warnings();
+    if (!pinned) warnings.push_back("benchmark thread is not pinned to a single CPU");
+    for (const auto& w : warnings)
+        std::fprintf(stderr, "llti: WARNING: %s\n", w.c_str());
+    if (strict && !warnings.empty()) {
+        std::fprintf(stderr, "llti: refusing to run on a noisy configuration (--llti_strict=1)\n");
+        return 2;
+    }
+
+    calibrate(topo, calibrate_mode.empty() ? "quick" : calibrate_mode);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+#if defined(LLTI_PROBES)
+    llti::probe::init_thread();
+#endif
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+#if defined(LLTI_PROBES)
+    if (probe_out.empty()) probe_out = "llti_probes.txt";
+    if (!llti::probe::dump(probe_out, g_tsc_hz))
+        std::fprintf(stderr, "llti: could not write probe dump %s\n", probe_out.c_str());
+#endif
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "bench_common.h"
+#include "llti/btree_map.h"
+#include "llti/sorted_lookup.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+// BTreeMap against std::map at 1M-100M random keys.
+//
+// BM_MapMixed runs a read/write mix over `keys` live keys: each operation
+// is a find of a random live key, or with probability write_pct% a write
+// that erases a random live key and inserts a fresh one, so the size stays
+// put. BM_MapRangeScan visits the ~100 keys after a random live key. The
+// B+tree is bulk-loaded from a SortedLookup of the keys; std::map is
+// filled in key order with an end() hint, its cheapest build.
+//
+// Rows that would not fit in half of RAM are skipped (100M keys need
+// ~10 GB for std::map).
+
+namespace {
+
+constexpr size_t BATCH = 1 << 16;
+constexpr int64_t kScanKeys = 100;
+
+struct BTreeAdapter {
+    static constexpr size_t kBytesPerKey = 40;  // nodes at 3/4 fill + load-time SortedLookup
+    llti::BTreeMap<int64_t> map;
+
+    void load(const std::vector<std::pair<int64_t, int64_t>>& entries) {
+        llti::SortedLookup<int64_t> sorted;
+        sorted.build(entries);
+        map.bulk_load(sorted);
+    }
+    const int64_t* find(int64_t k) const { return map.find(k); }
+    void insert(int64_t k, int64_t v) { map.insert(k, v); }
+    void erase(int64_t k) { map.erase(k); }
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn&& fn) const { map.scan(lo, hi, fn); }
+};
+
+struct StdMapAdapter {
+    static constexpr size_t kBytesPerKey = 64;  // 48-byte node plus malloc overhead
+    std::map<int64_t, int64_t> map;
+
+    void load(std::vector<std::pair<int64_t, int64_t>> entries) {
+        std::sort(entries.begin(), entries.end());
+        for (const auto& [k, v] : entries) map.emplace_hint(map.end(), k, v);
+    }
+    const int64_t* find(int64_t k) const {
+        auto it = map.find(k);
+        return it != map.end() ? &it->second : nullptr;
+    }
+    void insert(int64_t k, int64_t v) { map.insert_or_assign(k, v); }
+    void erase(int64_t k) { map.erase(k); }
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn&& fn) const {
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first <= hi; ++it)
+            fn(it->first, it->second);
+    }
+};
+
+// The map plus the live-key list (8 bytes a key) and the 16-byte entries.
+template <class Map>
+bool fits_in_ram(int64_t n) {
+    return static_cast<size_t>(n) * (Map::kBytesPerKey + 24) <= physical_ram_bytes() / 2;
+}
+
+// A map loaded with n random keys, and those keys.
+template <class Map>
+struct Loaded {
+    std::unique_ptr<Map> map = std::make_unique<Map>();
+    std::vector<int64_t> live;
+
+    explicit Loaded(int64_t n) {
+        auto entries = make_entries(n);
+        live.reserve(entries.size());
+        for (const auto& e : entries) live.push_back(e.first);
+        map->load(std::move(entries));
+    }
+};
+
+void map_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"keys", "write_pct"});
+    for (int64_t n : {1'000'000, 10'000'000, 100'000'000})
+        for (int64_t w : {0, 10, 50}) b->Args({n, w});
+}
+
+}  // namespace
+
+template <class Map>
+static void BM_MapMixed(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    if (!fits_in_ram<Map>(n)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    Loaded<Map> loaded(n);
+    std::mt19937_64 rng(99);
+    // Per slot: which live key, and whether it is a write.
+    std::vector<std::pair<size_t, bool>> ops(BATCH);
+    for (auto& [pos, write] : ops) {
+        pos = rng() % loaded.live.size();
+        write = static_cast<int64_t>(rng() % 100) < state.range(1);
+    }
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto [pos, write] = ops[idx];
+        int64_t& key = loaded.live[pos];
+        if (write) {
+            loaded.map->erase(key);
+            key = static_cast<int64_t>(rng());
+            loaded.map->insert(key, key);
+        } else {
+            benchmark::DoNotOptimize(loaded.map->find(key));
+        }
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MapMixed, BTreeAdapter)->Apply(map_args);
+BENCHMARK_TEMPLATE(BM_MapMixed, StdMapAdapter)->Apply(map_args);
+
+template <class Map>
+static void BM_MapRangeScan(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    if (!fits_in_ram<Map>(n)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    Loaded<Map> loaded(n);
+    const int64_t span = static_cast<int64_t>(UINT64_MAX / static_cast<uint64_t>(n) * kScanKeys);
+    std::mt19937_64 rng(99);
+    std::vector<int64_t> starts(BATCH);
+    for (auto& s : starts) s = loaded.live[rng() % loaded.live.size()];
+    size_t idx = 0;
+    int64_t visited = 0;
+    for (auto _ : state) {
+        int64_t lo = starts[idx];
+        int64_t hi = lo > INT64_MAX - span ? INT64_MAX : lo + span;
+        loaded.map->scan(lo, hi, [&](int64_t, const int64_t& v) {
+            benchmark::DoNotOptimize(v);
+            ++visited;
+        });
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    state.counters["keys_per_scan"] =
+        static_cast<double>(visited) / static_cast<double>(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_MapRangeScan, BTreeAdapter)
+    ->ArgName("keys")->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000);
+BENCHMARK_TEMPLATE(BM_MapRangeScan, StdMapAdapter)
+    ->ArgName("keys")->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000);
@@ -0,0 +1,55 @@
+#include "llti/calibration.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+// Full latency curve as regular benchmarks, for plotting. The summary that
+// benchmark_main.cpp attaches to every run is derived from the same chase.
+
+static void BM_PointerChase(benchmark::State& state) {
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    const bool huge = state.range(1) != 0;
+    llti::ChaseBuffer buf(bytes, huge);
+
+    void* p = buf.head();
+    for (size_t i = 0; i < buf.lines(); ++i) p = *static_cast<void**>(p);  // fault in
+    for (auto _ : state) {
+        p = *static_cast<void**>(p);
+        benchmark::DoNotOptimize(p);
+    }
+    state.SetLabel(huge ? "thp" : "4k");
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_PointerChase)
+    ->ArgNames({"bytes", "huge"})
+    ->RangeMultiplier(4)
+    ->Ranges({{4 << 10, 1 << 30}, {0, 1}});
+
+static void BM_StreamRead(benchmark::State& state) {
+    const size_t words = static_cast<size_t>(state.range(0)) / sizeof(uint64_t);
+    std::vector<uint64_t> buf(words, 1);
+    for (auto _ : state) {
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (size_t i = 0; i + 4 <= words; i += 4) {
+            s0 += buf[i];
+            s1 += buf[i + 1];
+            s2 += buf[i + 2];
+            s3 += buf[i + 3];
+        }
+        benchmark::DoNotOptimize(s0 + s1 + s2 + s3);
+    }
+    state.SetBytesProcessed(state.iterations() * words * sizeof(uint64_t));
+}
+BENCHMARK(BM_StreamRead)->Arg(256 << 20);
+
+static void BM_StreamWrite(benchmark::State& state) {
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    std::vector<char> buf(bytes, 1);
+    int v = 0;
+    for (auto _ : state) {
+        std::memset(buf.data(), ++v, bytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_StreamWrite)->Arg(256 << 20);
@@ -0,0 +1,173 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/sorted_lookup.h"
+#include "llti/veb_lookup.h"
+#include <benchmark/benchmark.h>
+#include <sys/mman.h>
+#include <immintrin.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Cold-cache lookups: one lookup into a table nothing has touched recently,
+// the situation of a risk check on a rarely traded symbol. The warm loops in
+// lookup_benchmark.cpp keep the top of every tree cache-resident and can
+// never show this cost.
+//
+// Before each timed lookup the lines that lookup will touch (replayed from
+// each layout's search loop, including the lines its prefetches pull in)
+// are evicted with clflushopt:
+//   cold=0  no flush: the reference, with the same random keys, fences
+//           and timing overhead (the 10M-key paths still miss below the
+//           top levels, but the top of each tree stays cached)
+//   cold=1  flushed lines, TLB still warm: pure cache-miss cost
+//   cold=2  flushed lines, then a sweep touching one line in each of 16K
+//           4 KB pages (well beyond any STLB), so the lookup also pays
+//           first-touch page walks
+// Flushing only the touched lines, rather than sweeping a buffer larger
+// than the LLC, keeps each iteration in the microseconds on hosts with
+// hundreds of MB of L3.
+//
+// Time is manual (rdtscp around the lookup alone); the Time column is the
+// mean cold latency, p50/p99 come from LatencyRecorder.
+
+namespace {
+
+enum ColdMode { kWarm = 0, kFlush = 1, kFlushTlb = 2 };
+
+inline void flush_line(const void* p) {
+#if defined(__CLFLUSHOPT__)
+    _mm_clflushopt(const_cast<void*>(p));
+#else
+    _mm_clflush(p);
+#endif
+}
+
+// Lines a lookup touches, replayed outside the timed region.
+void touched_lines(const llti::SortedLookup<int64_t>& t, int64_t target,
+                   std::vector<const void*>& out) {
+    // std::lower_bound's probe sequence.
+    size_t first = 0, len = t.keys.size();
+    while (len > 0) {
+        size_t half = len / 2;
+        out.push_back(&t.keys[first + half]);
+        if (t.keys[first + half] < target) {
+            first += half + 1;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+    if (first < t.keys.size()) out.push_back(&t.keys[first]);
+}
+
+void touched_lines(const llti::EytzingerLookup<int64_t>& t, int64_t target,
+                   std::vector<const void*>& out) {
+    size_t i = 1;
+    while (i <= t.n) {
+        out.push_back(&t.keys[i]);
+        if (2 * i < t.keys.size()) out.push_back(&t.keys[2 * i]);  // prefetch
+        i = 2 * i + (t.keys[i] < target);
+    }
+    i >>= __builtin_ffs(static_cast<int>(~i));
+    if (i > 0 && i <= t.n) out.push_back(&t.keys[i]);
+}
+
+void touched_lines(const llti::VebLookup<int64_t>& t, int64_t target,
+                   std::vector<const void*>& out) {
+    uint32_t curr = t.root_idx;
+    while (curr != 0) {
+        const auto& node = t.tree[curr];
+        out.push_back(&node);
+        out.push_back(&t.tree[node.children[0]]);  // prefetches
+        out.push_back(&t.tree[node.children[1]]);
+        curr = node.children[node.key < target];
+    }
+}
+
+// One line per 4 KB page over 16K pages (64 MB of address space, 1 MB of
+// lines): enough distinct pages to evict the DTLB and STLB, small enough
+// to touch in well under a millisecond.
+class TlbSweep {
+public:
+    static constexpr size_t kPages = 16384;
+    static constexpr size_t kPage = 4096;
+
+    TlbSweep() {
+        void* p = mmap(nullptr, kPages * kPage, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        madvise(p, kPages * kPage, MADV_NOHUGEPAGE);
+        base_ = static_cast<char*>(p);
+        for (size_t i = 0; i < kPages; ++i) base_[i * kPage] = 1;
+    }
+    ~TlbSweep() { munmap(base_, kPages * kPage); }
+    TlbSweep(const TlbSweep&) = delete;
+    TlbSweep& operator=(const TlbSweep&) = delete;
+
+    void run() {
+        uint64_t sum = 0;
+        // Vary the in-page offset so the sweep lines spread over cache sets.
+        for (size_t i = 0; i < kPages; ++i) sum += base_[i * kPage + ((i & 63) << 6)];
+        benchmark::DoNotOptimize(sum);
+    }
+
+private:
+    char* base_ = nullptr;
+};
+
+// Fixed iteration counts: manual time only counts the lookup, so a
+// min-time target would keep flushing for minutes.
+void cold_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("cold")->Arg(kWarm)->Arg(kFlush)->Arg(kFlushTlb);
+    b->UseManualTime()->Iterations(20'000);
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_ColdLookup(benchmark::State& state) {
+    const Table& table = shared_table<Table>();
+    const auto mode = static_cast<ColdMode>(state.range(0));
+
+    // Random existing keys; each is used once per lap so consecutive
+    // lookups share no path below the root.
+    auto entries = make_entries(kLookupN);
+    constexpr size_t BATCH = 1 << 14;
+    std::mt19937_64 rng(123);
+    std::vector<int64_t> lookup_keys(BATCH);
+    for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+    entries = {};
+
+    std::unique_ptr<TlbSweep> sweep;
+    if (mode == kFlushTlb) sweep = std::make_unique<TlbSweep>();
+
+    LatencyRecorder latency;
+    std::vector<const void*> lines;
+    lines.reserve(256);
+    const double ns_per_tick = 1e9 / host_tsc_hz();
+    size_t idx = 0;
+    for (auto _ : state) {
+        int64_t key = lookup_keys[idx];
+        if (mode != kWarm) {
+            lines.clear();
+            touched_lines(table, key, lines);
+            for (const void* p : lines) flush_line(p);
+            // After the flushes: each clflushopt translates its address and
+            // would reload the very TLB entries the sweep just evicted.
+            if (sweep) sweep->run();
+        }
+        _mm_mfence();
+        uint64_t t0 = llti::rdtscp();
+        auto* val = table.find(key);
+        benchmark::DoNotOptimize(val);
+        uint64_t t1 = llti::rdtscp();
+        latency.record(t1 - t0);
+        state.SetIterationTime((t1 - t0) * ns_per_tick * 1e-9);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    latency.report(state);
+}
+BENCHMARK_TEMPLATE(BM_ColdLookup, llti::SortedLookup<int64_t>)->Apply(cold_args);
+BENCHMARK_TEMPLATE(BM_ColdLookup, llti::EytzingerLookup<int64_t>)->Apply(cold_args);
+BENCHMARK_TEMPLATE(BM_ColdLookup, llti::VebLookup<int64_t>)->Apply(cold_args);
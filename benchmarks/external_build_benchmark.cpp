@@ -0,0 +1,171 @@
+#include "bench_common.h"
+#include "llti/external_builder.h"
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+extern char** environ;
+
+// External-memory build of an Eytzinger file from an unsorted input four
+// times the memory limit.
+//
+// Each row stands for a memory limit of limit_MB: the input holds
+// 4 * limit_MB of random 16-byte records and the build gets half the
+// limit as its buffer budget. Every iteration drops the input and output
+// from the page cache and runs the build in llti_external_build (built
+// next to this binary), so input_GB (per second) includes reading the
+// input from disk and writing the output back. peak_MB is the helper's
+// own VmHWM. A forked child would report its parent's resident tables
+// too, and so would wait4's ru_maxrss, even after exec. peak_MB staying
+// under limit_MB is the point.
+//
+// To enforce the limit rather than just measure against it, run the
+// binary in a cgroup, e.g.
+//   systemd-run --scope -p MemoryMax=300M ./llti_benchmarks
+//       --benchmark_filter=ExternalBuild/limit_MB:256
+// Rows above the cgroup's memory.max are skipped. Files go in
+// LLTI_BENCH_DIR (default /var/tmp); keep it off tmpfs, whose pages count
+// as memory.
+
+namespace {
+
+std::string bench_dir() {
+    const char* dir = std::getenv("LLTI_BENCH_DIR");
+    return dir ? dir : "/var/tmp";
+}
+
+// memory.max of this process's cgroup (v2), or 0 if unlimited or unknown.
+uint64_t cgroup_memory_max() {
+    std::ifstream cgroup("/proc/self/cgroup");
+    std::string line;
+    if (!std::getline(cgroup, line) || line.rfind("0::", 0) != 0) return 0;
+    std::ifstream max("/sys/fs/cgroup" + line.substr(3) + "/memory.max");
+    std::string value;
+    if (!(max >> value) || value == "max") return 0;
+    return std::stoull(value);
+}
+
+// Writes `bytes` of random records to `path` in 64 MB chunks.
+void write_input(const std::string& path, uint64_t bytes) {
+    using Rec = llti::Record<int64_t>;
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("cannot create " + path);
+    std::mt19937_64 rng(42);
+    std::vector<Rec> chunk((64 << 20) / sizeof(Rec));
+    for (uint64_t left = bytes / sizeof(Rec); left > 0;) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(left, chunk.size()));
+        for (size_t i = 0; i < count; ++i) chunk[i] = Rec{static_cast<int64_t>(rng()), int64_t(i)};
+        std::fwrite(chunk.data(), sizeof(Rec), count, f);
+        left -= count;
+    }
+    std::fclose(f);
+}
+
+void drop_from_page_cache(const std::string& path) {
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+// llti_external_build from this binary's directory.
+std::string helper_path() {
+    char exe[4096];
+    ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (len <= 0) return "llti_external_build";
+    return llti::external_detail::directory_of(std::string(exe, len)) + "/llti_external_build";
+}
+
+// Runs the helper with `args` and returns its peak_rss_kb, or -1 if it
+// could not be started or failed.
+double run_helper(const std::vector<std::string>& args) {
+    int out[2];
+    if (pipe(out) != 0) return -1;
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, out[0]);
+    std::vector<char*> argv;
+    for (const auto& a : args) argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+    pid_t pid;
+    int err = posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(out[1]);
+
+    std::string text;
+    char buf[256];
+    for (ssize_t got; err == 0 && (got = read(out[0], buf, sizeof(buf))) > 0;) text.append(buf, got);
+    close(out[0]);
+    if (err != 0) return -1;
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return -1;
+
+    std::istringstream lines(text);
+    std::string name;
+    double value;
+    while (lines >> name >> value)
+        if (name == "peak_rss_kb") return value;
+    return -1;
+}
+
+}  // namespace
+
+static void BM_ExternalBuild(benchmark::State& state) {
+    const uint64_t limit = static_cast<uint64_t>(state.range(0)) << 20;
+    const uint64_t cgroup_max = cgroup_memory_max();
+    if (cgroup_max != 0 && cgroup_max < limit) {
+        state.SkipWithError("row's limit is above this cgroup's memory.max");
+        return;
+    }
+    const std::string base = bench_dir() + "/llti-bench-external-" + std::to_string(getpid());
+    const std::string input = base + ".in";
+    const std::string output = base + ".eyt";
+    write_input(input, 4 * limit);
+
+    const std::vector<std::string> args = {
+        helper_path(), input, output, "--budget_mb=" + std::to_string((limit / 2) >> 20),
+        "--temp_dir=" + bench_dir()};
+    double peak_kb = 0.0;
+    bool failed = false;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        drop_from_page_cache(input);
+        drop_from_page_cache(output);
+        state.ResumeTiming();
+
+        double kb = run_helper(args);
+        drop_from_page_cache(output);  // count the write-back in the time
+        failed |= kb < 0;
+        peak_kb = std::max(peak_kb, kb);
+    }
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    if (failed) {
+        state.SkipWithError(("build failed (is " + args[0] + " built?)").c_str());
+        return;
+    }
+
+    const double input_bytes = static_cast<double>(4 * limit);
+    state.SetBytesProcessed(static_cast<int64_t>(input_bytes) * state.iterations());
+    state.counters["input_GB"] = benchmark::Counter(input_bytes / 1e9 * state.iterations(),
+                                                    benchmark::Counter::kIsRate);
+    state.counters["input_MB"] = input_bytes / (1 << 20);
+    state.counters["peak_MB"] = peak_kb / 1024;
+}
+BENCHMARK(BM_ExternalBuild)->ArgName("limit_MB")->Arg(64)->Arg(256)->Iterations(1)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
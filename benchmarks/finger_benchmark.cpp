@@ -0,0 +1,67 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/sorted_lookup.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Finger search on locally correlated query streams over the shared
+// 10M-key tables. stream 0 is a monotone replay (each query 0..3 keys past
+// the previous one), 1 a random walk (+-64 keys per step), 2 uniform
+// random keys. finger=0 runs find() on the same stream, so each row pair
+// shows what find_from saves over a root descent at equal cache warmth.
+
+namespace {
+
+constexpr size_t BATCH = 1 << 16;
+
+std::vector<int64_t> make_stream(int stream) {
+    auto entries = make_entries(kLookupN);
+    std::vector<int64_t> sorted(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) sorted[i] = entries[i].first;
+    std::sort(sorted.begin(), sorted.end());
+
+    std::mt19937_64 rng(99);
+    const int64_t n = static_cast<int64_t>(sorted.size());
+    int64_t rank = n / 2;
+    std::vector<int64_t> keys(BATCH);
+    for (auto& k : keys) {
+        if (stream == 0) rank = (rank + static_cast<int64_t>(rng() % 4)) % n;
+        else if (stream == 1) rank = std::clamp<int64_t>(rank + static_cast<int64_t>(rng() % 129) - 64, 0, n - 1);
+        else rank = static_cast<int64_t>(rng() % n);
+        k = sorted[rank];
+    }
+    return keys;
+}
+
+void finger_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"stream", "finger"});
+    for (int stream : {0, 1, 2})
+        for (int finger : {0, 1}) b->Args({stream, finger});
+}
+
+template <class Table>
+void run_stream(benchmark::State& state, const Table& table) {
+    auto keys = make_stream(static_cast<int>(state.range(0)));
+    bool finger = state.range(1) != 0;
+    typename Table::Cursor cursor;
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = finger ? table.find_from(cursor, keys[idx]) : table.find(keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+
+}  // namespace
+
+static void BM_FingerSorted(benchmark::State& state) {
+    run_stream(state, shared_table<llti::SortedLookup<int64_t>>());
+}
+BENCHMARK(BM_FingerSorted)->Apply(finger_args);
+
+static void BM_FingerEytzinger(benchmark::State& state) {
+    run_stream(state, shared_table<llti::EytzingerLookup<int64_t>>());
+}
+BENCHMARK(BM_FingerEytzinger)->Apply(finger_args);
@@ -0,0 +1,92 @@
+#include "bench_common.h"
+#include "llti/static_hash_lookup.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// StaticHashLookup at 1M / 10M / 100M keys: hit and miss latency (a miss
+// probes both buckets, so it should cost the same as a hit), table bytes
+// per key, and build time. Sizes that would not fit in half of RAM
+// (~64 bytes per key during the build) are skipped, so the 100M rows need
+// a host with 16 GB.
+
+namespace {
+
+using HashTable = llti::StaticHashLookup<int64_t>;
+
+bool fits_in_ram(int64_t n) {
+    return static_cast<size_t>(n) * 64 <= physical_ram_bytes() / 2;
+}
+
+// The most recently built table; hit and miss rows for one size run back
+// to back, so each size is built once.
+const HashTable& cached_table(int64_t n) {
+    static std::unique_ptr<HashTable> table;
+    static int64_t built_n = -1;
+    if (built_n != n) {
+        table.reset();
+        table = std::make_unique<HashTable>();
+        table->build(make_entries(n));
+        built_n = n;
+    }
+    return *table;
+}
+
+void size_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "miss"});
+    for (int64_t n : {1'000'000, 10'000'000, 100'000'000})
+        for (int miss : {0, 1})
+            b->Args({n, miss});
+}
+
+}  // namespace
+
+static void BM_StaticHashLookup(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    const bool miss = state.range(1) != 0;
+    if (!fits_in_ram(n)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    const HashTable& table = cached_table(n);
+
+    // 64K query keys: existing keys for hits, fresh random keys for misses
+    // (a collision with 100M stored keys has probability ~5e-12).
+    constexpr size_t BATCH = 1 << 16;
+    std::vector<int64_t> lookup_keys(BATCH);
+    std::mt19937_64 rng(99);
+    if (miss) {
+        for (auto& k : lookup_keys) k = static_cast<int64_t>(rng());
+    } else {
+        auto entries = make_entries(n);
+        for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+    }
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(lookup_keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    state.counters["bytes_per_key"] = table.bytes_per_key();
+}
+BENCHMARK(BM_StaticHashLookup)->Apply(size_args);
+
+static void BM_StaticHashLookup_Build(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    if (!fits_in_ram(n)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    auto entries = make_entries(n);
+    for (auto _ : state) {
+        HashTable table;
+        auto copy = entries;
+        table.build(std::move(copy));
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_StaticHashLookup_Build)->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,72 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/interpolation_lookup.h"
+#include "llti/sorted_lookup.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Interpolation search against the comparison layouts on key sets where it
+// wins, where it struggles, and where it would go linear without its guard:
+//   dist=0  uniform random int64 (make_entries): ~3 interpolation probes
+//   dist=1  clustered: 1000 dense clusters at random centres, so the first
+//           guess lands in the right cluster but not near the key
+//   dist=2  adversarial: keys 0..n-2 plus one INT64_MAX outlier; every
+//           unguarded guess lands at the low end of the interval, which
+//           is what the bad-guess fallback to binary search is for
+// Query keys are random existing keys, as in lookup_benchmark.cpp.
+
+namespace {
+
+enum Dist { kUniform = 0, kClustered = 1, kAdversarial = 2 };
+
+std::vector<std::pair<int64_t, int64_t>> make_dist_entries(Dist dist, int64_t n) {
+    if (dist == kUniform) return make_entries(n);
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    entries.reserve(n);
+    std::mt19937_64 rng(42);
+    if (dist == kClustered) {
+        constexpr int64_t kClusters = 1000;
+        for (int64_t c = 0; c < kClusters; ++c) {
+            int64_t centre = static_cast<int64_t>(rng() >> 2);
+            for (int64_t i = 0; i < n / kClusters; ++i) {
+                int64_t key = centre + static_cast<int64_t>(rng() % (n / kClusters * 16));
+                entries.push_back({key, key});
+            }
+        }
+    } else {
+        for (int64_t i = 0; i < n - 1; ++i) entries.push_back({i, i});
+        entries.push_back({std::numeric_limits<int64_t>::max(), 0});
+    }
+    return entries;
+}
+
+void dist_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("dist")->Arg(kUniform)->Arg(kClustered)->Arg(kAdversarial);
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_InterpolationCompare(benchmark::State& state) {
+    auto entries = make_dist_entries(static_cast<Dist>(state.range(0)), kLookupN);
+    constexpr size_t BATCH = 1 << 16;
+    std::mt19937_64 rng(99);
+    std::vector<int64_t> lookup_keys(BATCH);
+    for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+
+    Table table;
+    table.build(std::move(entries));
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(lookup_keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+BENCHMARK_TEMPLATE(BM_InterpolationCompare, llti::InterpolationLookup<int64_t>)->Apply(dist_args);
+BENCHMARK_TEMPLATE(BM_InterpolationCompare, llti::EytzingerLookup<int64_t>)->Apply(dist_args);
+BENCHMARK_TEMPLATE(BM_InterpolationCompare, llti::SortedLookup<int64_t>)->Apply(dist_args);
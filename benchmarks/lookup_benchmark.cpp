@@ -1,18 +1,21 @@
+#include "bench_common.h"
 #include "llti/eytzinger_lookup.h"
 #include "llti/sorted_lookup.h"
 #include <benchmark/benchmark.h>
 #include <random>
 
-// Shared setup: generate 10M random key-value pairs
-static std::vector<std::pair<int64_t, int64_t>> make_entries(int64_t n, uint64_t seed = 42) {
-    std::mt19937_64 rng(seed);
-    std::vector<std::pair<int64_t, int64_t>> entries;
-    entries.reserve(n);
-    for (int64_t i = 0; i < n; ++i) {
-        int64_t key = static_cast<int64_t>(rng());
-        entries.push_back({key, key});
-    }
-    return entries;
+// Attach the calibration model's prediction for this layout: expected lines
+// fetched from beyond L1/L2/L3 per lookup and the latency they imply.
+static void report_expected_misses(benchmark::State& state, llti::SearchLayout layout, size_t n) {
+    const auto& cal = host_calibration();
+    if (cal.curve.empty()) return;
+    double m1 = llti::expected_misses(layout, n, cal.l1_bytes);
+    double m2 = llti::expected_misses(layout, n, cal.l2_bytes);
+    double m3 = llti::expected_misses(layout, n, cal.l3_bytes);
+    state.counters["exp_miss_L1"] = m1;
+    state.counters["exp_miss_L2"] = m2;
+    state.counters["exp_miss_L3"] = m3;
+    state.counters["model_ns"] = cal.predict_ns(m1, m2, m3);
 }
 
 // --- Sorted (baseline) ---
@@ -38,6 +41,7 @@ static void BM_SortedLookup_10M(benchmark::State& state) {
         benchmark::DoNotOptimize(val);
         idx = (idx + 1) & (BATCH - 1);
     }
+    report_expected_misses(state, llti::SearchLayout::Sorted, N);
 }
 BENCHMARK(BM_SortedLookup_10M);
 
@@ -65,6 +69,7 @@ static void BM_EytzingerLookup_10M(benchmark::State& state) {
         benchmark::DoNotOptimize(val);
         idx = (idx + 1) & (BATCH - 1);
     }
+    report_expected_misses(state, llti::SearchLayout::Eytzinger, N);
 }
 BENCHMARK(BM_EytzingerLookup_10M);
 
@@ -122,6 +127,7 @@ static void BM_VebLookup_10M(benchmark::State& state) {
         benchmark::DoNotOptimize(val);
         idx = (idx + 1) & (BATCH - 1);
     }
+    report_expected_misses(state, llti::SearchLayout::Veb, N);
 }
 BENCHMARK(BM_VebLookup_10M);
 
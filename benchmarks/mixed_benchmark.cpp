@@ -0,0 +1,71 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/order_book.h"
+#include "llti/veb_lookup.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Book updates and reference-data lookups on one core.
+//
+// In production the thread that applies order book messages also looks up
+// instrument data, so each evicts the other's working set: the book's
+// price levels, pool and id map against the upper levels of a 10M-key
+// table. Each iteration applies `book` book messages and then `lookups`
+// lookups, timing every operation, and reports book_p50_ns ... and
+// lookup_p50_ns ... separately. The {1,0} and {0,1} rows are the
+// uncontended references for the same harness.
+
+namespace {
+
+void mix_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"book", "lookups"});
+    b->Args({1, 0});
+    b->Args({0, 1});
+    for (auto [book, lookups] : {std::pair{4, 1}, {1, 1}, {1, 4}, {1, 16}})
+        b->Args({book, lookups});
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_MixedBookLookup(benchmark::State& state) {
+    const Table& table = shared_table<Table>();
+    const int book_per_iter = static_cast<int>(state.range(0));
+    const int lookups_per_iter = static_cast<int>(state.range(1));
+
+    auto entries = make_entries(kLookupN);
+    constexpr size_t BATCH = 1 << 16;
+    std::mt19937_64 rng(99);
+    std::vector<int64_t> lookup_keys(BATCH);
+    for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+    entries = {};
+
+    static const std::vector<BookOp> ops = make_book_ops(2'000'000);
+    auto book = std::make_unique<llti::OrderBook>(kBookMinTick, kBookMaxTick);
+
+    LatencyRecorder book_latency, lookup_latency;
+    size_t op_idx = 0, key_idx = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < book_per_iter; ++i) {
+            uint64_t t0 = llti::rdtsc();
+            apply_op(*book, ops[op_idx]);
+            benchmark::ClobberMemory();
+            book_latency.record(llti::rdtsc() - t0);
+            if (++op_idx == ops.size()) op_idx = 0;
+        }
+        for (int i = 0; i < lookups_per_iter; ++i) {
+            uint64_t t0 = llti::rdtsc();
+            auto* val = table.find(lookup_keys[key_idx]);
+            benchmark::DoNotOptimize(val);
+            lookup_latency.record(llti::rdtsc() - t0);
+            key_idx = (key_idx + 1) & (BATCH - 1);
+        }
+    }
+    book_latency.report(state, "book_");
+    lookup_latency.report(state, "lookup_");
+    state.SetItemsProcessed(state.iterations() * (book_per_iter + lookups_per_iter));
+}
+BENCHMARK_TEMPLATE(BM_MixedBookLookup, llti::EytzingerLookup<int64_t>)->Apply(mix_args);
+BENCHMARK_TEMPLATE(BM_MixedBookLookup, llti::VebLookup<int64_t>)->Apply(mix_args);
@@ -0,0 +1,75 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/static_hash_lookup.h"
+#include "llti/thread_pool.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Batch lookup throughput against participant count: 1M queries per
+// iteration through parallel_find (work stealing, 4K-query chunks) or
+// parallel_for_static (one contiguous slice per participant, the naive
+// split), on the shared 10M-key tables.
+//   skew=0  uniform random existing keys: every slice costs the same, so
+//           static partitioning is the best case and stealing should
+//           only match it
+//   skew=1  the first half of the batch is random (DRAM-bound), the
+//           second half repeats 64 keys (cache-resident): static slices
+//           finish at very different times, stealing rebalances
+// items_per_second is lookups/s over the whole pool; pinned=0 means some
+// workers shared a core (the host has fewer cores than participants).
+
+namespace {
+
+constexpr size_t kQueries = size_t{1} << 20;
+
+std::vector<int64_t> batch_keys(bool skew) {
+    auto entries = make_entries(kLookupN);
+    std::mt19937_64 rng(99);
+    std::vector<int64_t> keys(kQueries);
+    for (size_t i = 0; i < kQueries; ++i) {
+        size_t pick = (skew && i >= kQueries / 2) ? rng() % 64 : rng() % entries.size();
+        keys[i] = entries[pick].first;
+    }
+    return keys;
+}
+
+void parallel_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"threads", "steal", "skew"});
+    std::vector<int64_t> counts;
+    int64_t hw = std::max(1u, std::thread::hardware_concurrency());
+    for (int64_t t = 1; t < hw; t *= 2) counts.push_back(t);
+    counts.push_back(hw);
+    for (int64_t skew : {0, 1})
+        for (int64_t steal : {1, 0})
+            for (int64_t t : counts) b->Args({t, steal, skew});
+    b->UseRealTime();
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_ParallelFind(benchmark::State& state) {
+    const Table& table = shared_table<Table>();
+    const size_t threads = static_cast<size_t>(state.range(0));
+    const bool steal = state.range(1) != 0;
+    auto keys = batch_keys(state.range(2) != 0);
+    std::vector<decltype(table.find(int64_t{}))> out(kQueries);
+
+    llti::ThreadPool pool(threads);
+    for (auto _ : state) {
+        if (steal) {
+            llti::parallel_find(pool, table, keys.data(), kQueries, out.data());
+        } else {
+            pool.parallel_for_static(kQueries, [&](size_t begin, size_t end) {
+                for (size_t q = begin; q < end; ++q) out[q] = table.find(keys[q]);
+            });
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kQueries);
+    state.counters["pinned"] = pool.pinned();
+}
+BENCHMARK_TEMPLATE(BM_ParallelFind, llti::EytzingerLookup<int64_t>)->Apply(parallel_args);
+BENCHMARK_TEMPLATE(BM_ParallelFind, llti::StaticHashLookup<int64_t>)->Apply(parallel_args);
@@ -0,0 +1,79 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/sorted_lookup.h"
+#include "llti/veb_lookup.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// Incremental rebuild of a 10M-key table against a full build. The delta
+// has `delta` changed keys: a quarter updates of existing keys, a quarter
+// new keys and half deletes of existing keys. Each iteration applies the
+// same delta to the same table, so after the first pass its deletes hit
+// nothing and its new keys become updates; the merge does the same O(n)
+// work either way. BM_FullBuild is build() on the full 10M entries,
+// including copying them, as BM_StaticHashLookup_Build does.
+
+namespace {
+
+struct Delta {
+    std::vector<std::pair<int64_t, int64_t>> upserts;
+    std::vector<int64_t> deletes;
+};
+
+Delta make_delta(const std::vector<std::pair<int64_t, int64_t>>& entries, int64_t size) {
+    std::mt19937_64 rng(7);
+    Delta delta;
+    for (int64_t i = 0; i < size; ++i) {
+        int64_t existing = entries[rng() % entries.size()].first;
+        switch (i % 4) {
+            case 0: delta.upserts.push_back({existing, -existing}); break;
+            case 1: {
+                int64_t key = static_cast<int64_t>(rng());
+                delta.upserts.push_back({key, key});
+                break;
+            }
+            default: delta.deletes.push_back(existing); break;
+        }
+    }
+    return delta;
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_RebuildWith(benchmark::State& state) {
+    auto entries = make_entries(kLookupN);
+    Delta delta = make_delta(entries, state.range(0));
+    Table table;
+    table.build(std::move(entries));
+    for (auto _ : state) {
+        table.rebuild_with(delta.upserts, delta.deletes);
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * kLookupN);
+}
+BENCHMARK_TEMPLATE(BM_RebuildWith, llti::SortedLookup<int64_t>)
+    ->ArgName("delta")->Arg(1'000)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RebuildWith, llti::EytzingerLookup<int64_t>)
+    ->ArgName("delta")->Arg(1'000)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RebuildWith, llti::VebLookup<int64_t>)
+    ->ArgName("delta")->Arg(1'000)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+template <class Table>
+static void BM_FullBuild(benchmark::State& state) {
+    auto entries = make_entries(kLookupN);
+    for (auto _ : state) {
+        Table table;
+        auto copy = entries;
+        table.build(std::move(copy));
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * kLookupN);
+}
+BENCHMARK_TEMPLATE(BM_FullBuild, llti::SortedLookup<int64_t>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FullBuild, llti::EytzingerLookup<int64_t>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FullBuild, llti::VebLookup<int64_t>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,87 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/lookup_service.h"
+#include "llti/tsc.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Client threads looking up keys in the shared 10M-key Eytzinger table,
+// either through a LookupService (one lookup thread draining an MPMC ring
+// in batches and descending each batch interleaved) or by calling find
+// directly. Each iteration is one client round: `window` requests
+// submitted back to back and then awaited (window=1 is a synchronous
+// call). items_per_second is the aggregate request rate; the p50/p99
+// counters are thread 0's end-to-end round latency, submit to last result.
+//
+// The service thread runs unpinned here; on a host with spare cores, pin it
+// (the cpu constructor argument) away from the clients.
+
+namespace {
+
+using Table = llti::EytzingerLookup<int64_t>;
+using Service = llti::LookupService<Table>;
+
+std::unique_ptr<Service> g_service;
+
+std::vector<int64_t> client_keys(int thread) {
+    const Table& table = shared_table<Table>();
+    std::mt19937_64 rng(1000 + thread);
+    std::vector<int64_t> keys(1 << 14);
+    for (auto& k : keys) k = table.keys[1 + rng() % table.n];
+    return keys;
+}
+
+void client_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("window")->Arg(1)->Arg(16);
+    b->ThreadRange(1, 4)->UseRealTime();
+}
+
+}  // namespace
+
+static void BM_ServiceLookup(benchmark::State& state) {
+    if (state.thread_index() == 0) g_service = std::make_unique<Service>(shared_table<Table>());
+    const size_t window = static_cast<size_t>(state.range(0));
+    auto keys = client_keys(state.thread_index());
+    std::vector<Service::Completion> slots(window);
+
+    LatencyRecorder latency;
+    size_t idx = 0;
+    for (auto _ : state) {
+        uint64_t t0 = llti::rdtsc();
+        for (size_t i = 0; i < window; ++i) {
+            while (!g_service->submit(keys[idx], slots[i])) llti::spin_backoff(64);
+            idx = (idx + 1) & (keys.size() - 1);
+        }
+        for (auto& slot : slots) benchmark::DoNotOptimize(slot.wait());
+        latency.record(llti::rdtsc() - t0);
+    }
+    state.SetItemsProcessed(state.iterations() * window);
+    if (state.thread_index() == 0) {
+        latency.report(state);
+        state.counters["batch_mean"] = static_cast<double>(g_service->served()) / g_service->batches();
+        g_service.reset();
+    }
+}
+BENCHMARK(BM_ServiceLookup)->Apply(client_args);
+
+static void BM_DirectLookup(benchmark::State& state) {
+    const Table& table = shared_table<Table>();
+    const size_t window = static_cast<size_t>(state.range(0));
+    auto keys = client_keys(state.thread_index());
+
+    LatencyRecorder latency;
+    size_t idx = 0;
+    for (auto _ : state) {
+        uint64_t t0 = llti::rdtsc();
+        for (size_t i = 0; i < window; ++i) {
+            benchmark::DoNotOptimize(table.find(keys[idx]));
+            idx = (idx + 1) & (keys.size() - 1);
+        }
+        latency.record(llti::rdtsc() - t0);
+    }
+    state.SetItemsProcessed(state.iterations() * window);
+    if (state.thread_index() == 0) latency.report(state);
+}
+BENCHMARK(BM_DirectLookup)->Apply(client_args);
@@ -0,0 +1,169 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/shared_table.h"
+#include <benchmark/benchmark.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Shared-memory tables against process-local ones, both 10M-key Eytzinger.
+//
+// BM_SharedTableLookup and BM_LocalTableLookup time random lookups through
+// a SharedTableReader and through the process's own EytzingerLookup; the
+// search is the same eytzinger_search, so any gap is the mapping (page
+// size, shmem vs anonymous memory).
+//
+// BM_SharedTableMemory forks readers-1 child processes that map the
+// segment and touch every page, then reads this process's share of it
+// from /proc/self/smaps: pss_MB is segment_MB / readers once every reader
+// has it mapped, where process-local tables would cost segment_MB each.
+// huge_MB is the part mapped with 2 MB pages (0 unless shmem THP is on).
+
+namespace {
+
+constexpr size_t BATCH = 1 << 16;
+
+std::string segment_name() { return "llti-bench-shared-table-" + std::to_string(getpid()); }
+
+// Published once per benchmark process and unlinked at exit.
+const llti::SharedTableReader<int64_t>& shared_reader() {
+    static const std::string name = segment_name();
+    static const auto reader = [] {
+        static llti::SharedTablePublisher<int64_t> publisher(name);
+        publisher.publish(make_entries(kLookupN));
+        std::atexit([] { llti::SharedTablePublisher<int64_t>::remove(name); });
+        return std::make_unique<llti::SharedTableReader<int64_t>>(name);
+    }();
+    return *reader;
+}
+
+// Reads one byte per 4 KB page so the whole mapping is resident.
+int64_t touch_pages(const void* base, size_t bytes) {
+    const volatile char* p = static_cast<const char*>(base);
+    int64_t sum = 0;
+    for (size_t off = 0; off < bytes; off += 4096) sum += p[off];
+    return sum;
+}
+
+// `field` (e.g. "Pss") in kB for the mapping starting at `start`.
+double smaps_kb(const void* start, const char* field) {
+    std::ifstream smaps("/proc/self/smaps");
+    char want[32];
+    std::snprintf(want, sizeof(want), "%lx-", reinterpret_cast<unsigned long>(start));
+    std::string line;
+    bool in_mapping = false;
+    size_t len = std::strlen(field);
+    while (std::getline(smaps, line)) {
+        if (line.find('-') < line.find(' ') && line.find(':') > line.find(' ')) {
+            in_mapping = line.compare(0, std::strlen(want), want) == 0;  // mapping header
+        } else if (in_mapping && line.compare(0, len, field) == 0 && line[len] == ':') {
+            return std::stod(line.substr(len + 1));
+        }
+    }
+    return 0.0;
+}
+
+template <class Table>
+void run_lookups(benchmark::State& state, const Table& table) {
+    auto entries = make_entries(kLookupN);
+    std::mt19937_64 rng(99);
+    std::vector<int64_t> keys(BATCH);
+    for (auto& k : keys) k = entries[rng() % entries.size()].first;
+    entries = {};
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+
+}  // namespace
+
+static void BM_SharedTableLookup(benchmark::State& state) {
+    const auto& reader = shared_reader();
+    run_lookups(state, reader);
+    state.counters["huge_MB"] = smaps_kb(reader.segment(), "ShmemPmdMapped") / 1024;
+}
+BENCHMARK(BM_SharedTableLookup);
+
+static void BM_LocalTableLookup(benchmark::State& state) {
+    run_lookups(state, shared_table<llti::EytzingerLookup<int64_t>>());
+}
+BENCHMARK(BM_LocalTableLookup);
+
+static void BM_SharedTableMemory(benchmark::State& state) {
+    const auto& reader = shared_reader();
+    const int readers = static_cast<int>(state.range(0));
+    const std::string name = segment_name();
+    double pss_kb = 0.0;
+
+    for (auto _ : state) {
+        // Children attach their own reader, touch every page, report on the
+        // pipe and wait to be killed.
+        int ready[2];
+        if (pipe(ready) != 0) {
+            state.SkipWithError("pipe failed");
+            return;
+        }
+        std::vector<pid_t> children;
+        auto reap = [&] {
+            for (pid_t pid : children) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+        };
+        for (int r = 1; r < readers; ++r) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(ready[0]);
+                close(ready[1]);
+                reap();
+                state.SkipWithError("fork failed");
+                return;
+            }
+            if (pid == 0) {
+                // Never unwind into the forked copy of the benchmark runner.
+                try {
+                    close(ready[0]);
+                    llti::SharedTableReader<int64_t> child(name);
+                    benchmark::DoNotOptimize(touch_pages(child.segment(), child.segment_bytes()));
+                    char byte = 1;
+                    if (write(ready[1], &byte, 1) != 1) _exit(1);
+                } catch (...) {
+                    _exit(1);
+                }
+                for (;;) pause();
+            }
+            children.push_back(pid);
+        }
+        close(ready[1]);
+        benchmark::DoNotOptimize(touch_pages(reader.segment(), reader.segment_bytes()));
+        char byte;
+        size_t attached = 0;
+        while (attached < children.size() && read(ready[0], &byte, 1) == 1) ++attached;
+        close(ready[0]);
+
+        pss_kb = smaps_kb(reader.segment(), "Pss");
+        reap();
+        if (attached < children.size()) {
+            state.SkipWithError("a child reader failed to attach");
+            return;
+        }
+    }
+    double segment_mb = static_cast<double>(reader.segment_bytes()) / (1 << 20);
+    state.counters["segment_MB"] = segment_mb;
+    state.counters["pss_MB"] = pss_kb / 1024;
+    state.counters["local_total_MB"] = segment_mb * readers;
+    state.counters["huge_MB"] = smaps_kb(reader.segment(), "ShmemPmdMapped") / 1024;
+}
+BENCHMARK(BM_SharedTableMemory)->ArgName("readers")->Arg(1)->Arg(4)->Arg(12)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
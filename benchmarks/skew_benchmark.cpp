@@ -0,0 +1,89 @@
+#include "bench_common.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/hot_key_lookup.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Skewed query mixes: 10M keys, queries drawn Zipf(s) over key rank with
+// s = zipf/100 in 0.5..1.5, where rank order is make_entries order (random
+// with respect to key order, so hot keys are scattered over the tree).
+// HotKeyLookup's weights come from a separate 1M-query sample trace, as
+// they would from a recorded production trace, and hot_weight_fraction
+// reports the share of that trace its 4096-key side table covers. Plain
+// Eytzinger on the same query stream is the reference; the side table has
+// to win back its extra probes on every cold query.
+
+namespace {
+
+// Inverse-CDF Zipf sampler over ranks [0, n).
+class ZipfSampler {
+public:
+    ZipfSampler(size_t n, double s) : cdf_(n) {
+        double sum = 0.0;
+        for (size_t r = 0; r < n; ++r) cdf_[r] = sum += std::pow(static_cast<double>(r + 1), -s);
+        for (auto& c : cdf_) c /= sum;
+    }
+
+    size_t operator()(std::mt19937_64& rng) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        size_t r = std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin();
+        return std::min(r, cdf_.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf_;
+};
+
+constexpr size_t BATCH = 1 << 16;
+
+std::vector<int64_t> zipf_keys(const std::vector<std::pair<int64_t, int64_t>>& entries,
+                               const ZipfSampler& zipf, size_t count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<int64_t> keys(count);
+    for (auto& k : keys) k = entries[zipf(rng)].first;
+    return keys;
+}
+
+void zipf_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("zipf");
+    for (int s : {50, 75, 100, 125, 150}) b->Arg(s);
+}
+
+}  // namespace
+
+static void BM_SkewedEytzinger(benchmark::State& state) {
+    const auto& table = shared_table<llti::EytzingerLookup<int64_t>>();
+    auto entries = make_entries(kLookupN);
+    auto keys = zipf_keys(entries, ZipfSampler(entries.size(), state.range(0) / 100.0), BATCH, 99);
+    entries = {};
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+BENCHMARK(BM_SkewedEytzinger)->Apply(zipf_args);
+
+static void BM_SkewedHotKey(benchmark::State& state) {
+    auto entries = make_entries(kLookupN);
+    ZipfSampler zipf(entries.size(), state.range(0) / 100.0);
+    auto keys = zipf_keys(entries, zipf, BATCH, 99);
+    auto trace = zipf_keys(entries, zipf, 1'000'000, 7);
+
+    llti::HotKeyLookup<int64_t> table;
+    table.build_from_trace(std::move(entries), std::move(trace));
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+    state.counters["hot_weight_fraction"] = table.hot_weight_fraction;
+}
+BENCHMARK(BM_SkewedHotKey)->Apply(zipf_args);
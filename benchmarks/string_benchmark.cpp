@@ -0,0 +1,153 @@
+#include "bench_common.h"
+#include "llti/string_eytzinger_lookup.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// String-keyed lookups: StringEytzingerLookup against std::map,
+// std::unordered_map and a sorted std::vector<std::string> with
+// lower_bound. kind 0 is ISIN-like keys (12 bytes: country code, 9
+// alphanumerics, check digit), which mostly differ within the first 8
+// bytes. kind 1 is OCC option symbols (21 bytes: root padded to 6, yymmdd,
+// C/P, 8-digit strike), where a few thousand roots and a few dozen expiries
+// make long shared stems and frequent 8-byte prefix ties.
+
+namespace {
+
+constexpr size_t BATCH = 1 << 16;
+
+std::vector<std::pair<std::string, int64_t>> make_string_entries(int kind, int64_t n) {
+    static const char kAlnum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static const char* kCountries[] = {"US", "GB", "DE", "FR", "JP", "CA", "AU", "CH"};
+    std::mt19937_64 rng(42);
+    std::vector<std::string> roots(4096);
+    for (auto& root : roots) {
+        root.assign(1 + rng() % 5, ' ');
+        for (auto& c : root) c = static_cast<char>('A' + rng() % 26);
+        root.resize(6, ' ');
+    }
+
+    std::vector<std::pair<std::string, int64_t>> entries;
+    entries.reserve(n);
+    for (int64_t i = 0; i < n; ++i) {
+        std::string key;
+        if (kind == 0) {
+            key = kCountries[rng() % 8];
+            for (int c = 0; c < 9; ++c) key += kAlnum[rng() % 36];
+            key += static_cast<char>('0' + rng() % 10);
+        } else {
+            key = roots[rng() % roots.size()];
+            key += std::to_string(240100 + 100 * (rng() % 12) + 1 + rng() % 28);
+            key += (rng() % 2) ? 'C' : 'P';
+            key += std::to_string(10000000 + rng() % 90000000);
+        }
+        entries.push_back({std::move(key), i});
+    }
+    return entries;
+}
+
+struct MapTable {
+    std::map<std::string, int64_t, std::less<>> map;
+    void build(std::vector<std::pair<std::string, int64_t>> entries) {
+        for (auto& e : entries) map.insert(std::move(e));
+    }
+    const int64_t* find(const std::string& key) const {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+};
+
+struct HashTable {
+    std::unordered_map<std::string, int64_t> map;
+    void build(std::vector<std::pair<std::string, int64_t>> entries) {
+        map.reserve(entries.size());
+        for (auto& e : entries) map.insert(std::move(e));
+    }
+    const int64_t* find(const std::string& key) const {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+};
+
+struct SortedStrings {
+    std::vector<std::string> keys;
+    std::vector<int64_t> vals;
+    void build(std::vector<std::pair<std::string, int64_t>> entries) {
+        std::sort(entries.begin(), entries.end());
+        keys.reserve(entries.size());
+        vals.reserve(entries.size());
+        for (auto& [k, v] : entries) {
+            keys.push_back(std::move(k));
+            vals.push_back(v);
+        }
+    }
+    const int64_t* find(const std::string& key) const {
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        return (it != keys.end() && *it == key) ? &vals[it - keys.begin()] : nullptr;
+    }
+};
+
+// One table alive at a time: the std containers need ~100-150 bytes per
+// key, so keeping every 10M-key table around would not fit small hosts.
+std::shared_ptr<void> current_table;
+const void* current_tag = nullptr;
+std::pair<int, int64_t> current_args{-1, -1};
+
+template <class Table>
+const Table& cached_table(int kind, int64_t n) {
+    static const char tag = 0;
+    if (current_tag != &tag || current_args != std::make_pair(kind, n)) {
+        current_table.reset();
+        auto table = std::make_shared<Table>();
+        table->build(make_string_entries(kind, n));
+        current_table = table;
+        current_tag = &tag;
+        current_args = {kind, n};
+    }
+    return *static_cast<const Table*>(current_table.get());
+}
+
+bool fits_in_ram(int64_t n) {
+    return static_cast<size_t>(n) * 256 <= physical_ram_bytes() / 2;
+}
+
+void string_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"kind", "n"});
+    for (int kind : {0, 1})
+        for (int64_t n : {1'000'000, 10'000'000}) b->Args({kind, n});
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_StringLookup(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    int64_t n = state.range(1);
+    if (!fits_in_ram(n)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+    const Table& table = cached_table<Table>(kind, n);
+
+    auto entries = make_string_entries(kind, n);
+    std::mt19937_64 rng(99);
+    std::vector<std::string> keys(BATCH);
+    for (auto& k : keys) k = entries[rng() % entries.size()].first;
+    entries = {};
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto* val = table.find(keys[idx]);
+        benchmark::DoNotOptimize(val);
+        idx = (idx + 1) & (BATCH - 1);
+    }
+}
+BENCHMARK_TEMPLATE(BM_StringLookup, llti::StringEytzingerLookup<int64_t>)->Apply(string_args);
+BENCHMARK_TEMPLATE(BM_StringLookup, SortedStrings)->Apply(string_args);
+BENCHMARK_TEMPLATE(BM_StringLookup, MapTable)->Apply(string_args);
+BENCHMARK_TEMPLATE(BM_StringLookup, HashTable)->Apply(string_args);
@@ -0,0 +1,82 @@
+#include "bench_common.h"
+#include "llti/compact_veb_lookup.h"
+#include "llti/veb_lookup.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// CompactVebLookup (relative child offsets, no 4B-entry limit) against
+// VebLookup on the shared 10M table: the same layout, so the difference is
+// the cost of decoding a relative link. With -DLLTI_BENCH_HUGE=ON the 5B
+// row runs too, past the point where VebLookup::build throws. It needs
+// about 40 bytes per key (input entries + tree + values), so ~200 GB, and
+// it skips itself on smaller hosts.
+//
+// The CompactVebLookup<int64_t, 23> row emulates the 5B tree's far links
+// on the 10M table: with 23-bit links, ~70% of the links out of the top
+// tree's bottom level go through `far`, about the share the 5B tree has
+// with 32-bit links. Its table is only 22 KB, so it shows the cost of the
+// extra dependent load from L1/L2, a lower bound for the 680 KB at 5B.
+
+namespace {
+
+bool fits_in_ram(int64_t n) {
+    return static_cast<size_t>(n) * 40 <= physical_ram_bytes();
+}
+
+template <class Table>
+void report_far_links(benchmark::State& state, const Table& table) {
+    if constexpr (!std::is_same_v<Table, llti::VebLookup<int64_t>>)
+        state.counters["far_links"] = static_cast<double>(table.far.size());
+}
+
+}  // namespace
+
+template <class Table>
+static void BM_VebScaleLookup(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    if (!fits_in_ram(n)) {
+        state.SkipWithError("not enough RAM for this size");
+        return;
+    }
+
+    constexpr size_t BATCH = 1 << 16;
+    std::vector<int64_t> lookup_keys(BATCH);
+    std::mt19937_64 rng(99);
+    auto lookup = [&](const Table& table) {
+        size_t idx = 0;
+        for (auto _ : state) {
+            auto* val = table.find(lookup_keys[idx]);
+            benchmark::DoNotOptimize(val);
+            idx = (idx + 1) & (BATCH - 1);
+        }
+    };
+
+    if (n == kLookupN) {
+        auto entries = make_entries(n);
+        for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+        entries = {};
+        lookup(shared_table<Table>());
+        report_far_links(state, shared_table<Table>());
+        return;
+    }
+    Table table;
+    {
+        auto entries = make_entries(n);
+        for (auto& k : lookup_keys) k = entries[rng() % entries.size()].first;
+        table.build(std::move(entries));
+    }
+    lookup(table);
+    report_far_links(state, table);
+}
+BENCHMARK_TEMPLATE(BM_VebScaleLookup, llti::VebLookup<int64_t>)->ArgName("n")->Arg(kLookupN);
+BENCHMARK_TEMPLATE(BM_VebScaleLookup, llti::CompactVebLookup<int64_t>)->ArgName("n")->Arg(kLookupN);
+BENCHMARK_TEMPLATE(BM_VebScaleLookup, llti::CompactVebLookup<int64_t, 23>)
+    ->ArgName("n")
+    ->Arg(kLookupN);
+#if defined(LLTI_BENCH_HUGE)
+BENCHMARK_TEMPLATE(BM_VebScaleLookup, llti::CompactVebLookup<int64_t>)
+    ->ArgName("n")
+    ->Arg(5'000'000'000)
+    ->Iterations(10'000'000);
+#endif
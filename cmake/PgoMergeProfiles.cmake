@@ -0,0 +1,42 @@
+# Turns the raw output of the PGO training run into what the
+# llti_benchmarks_pgo compile expects (see LLTI_OPTIMIZED_VARIANTS).
+#
+#   Clang: -DPGO_DIR=<dir> -DLLVM_PROFDATA=<tool>
+#          merges <dir>/*.profraw into <dir>/llti.profdata.
+#   GCC:   -DPGO_DIR=<dir> -DFROM=<gen object dir> -DTO=<use object dir>
+#          copies each mangled .gcda to the name the other target's
+#          objects will look up. FROM and TO are paths below the build
+#          directory, mangled '/' to '#' here: a '#' on the command line
+#          would start a make comment.
+
+if(LLVM_PROFDATA)
+    file(GLOB raw "${PGO_DIR}/*.profraw")
+    if(NOT raw)
+        message(FATAL_ERROR "PGO training wrote no .profraw files to ${PGO_DIR}")
+    endif()
+    execute_process(COMMAND ${LLVM_PROFDATA} merge -o ${PGO_DIR}/llti.profdata ${raw}
+        RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "llvm-profdata merge failed (${rc})")
+    endif()
+    return()
+endif()
+
+string(REPLACE "/" "#" FROM "${FROM}")
+string(REPLACE "/" "#" TO "${TO}")
+file(GLOB gcda "${PGO_DIR}/*.gcda")
+set(copied 0)
+foreach(src ${gcda})
+    get_filename_component(name ${src} NAME)
+    string(FIND "${name}" "#${FROM}#" at)
+    if(at EQUAL -1)
+        continue()
+    endif()
+    string(REPLACE "#${FROM}#" "#${TO}#" dst_name "${name}")
+    configure_file(${src} ${PGO_DIR}/${dst_name} COPYONLY)
+    math(EXPR copied "${copied} + 1")
+endforeach()
+if(copied EQUAL 0)
+    message(FATAL_ERROR "PGO training wrote no ${FROM} .gcda files to ${PGO_DIR}")
+endif()
+message(STATUS "PGO: ${copied} profiles prepared for ${TO}")
@@ -0,0 +1,588 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "llti/probe.h"
+
+namespace llti {
+
+// Adaptive radix tree over int64 keys, for key sets with constant inserts
+// and erases (live order IDs, client sessions) where the static layouts do
+// not apply.
+//
+// A key is split into 8 bytes, most significant first, with the sign bit
+// flipped so byte order is signed key order. Each inner node branches on
+// one byte and comes in four sizes, grown and shrunk as children come and
+// go:
+//   Node4, Node16  sorted byte array + parallel child array; Node16 finds
+//                  its byte with one 16-byte SIMD compare
+//   Node48         256-entry byte -> slot index, 48 child slots
+//   Node256        256 children indexed by the byte directly
+// Path compression: a node stores the absolute byte position it branches
+// on and one key from its subtree, so a chain of single-child levels
+// costs nothing. Sequential IDs sharing their top 5 bytes start at depth
+// 5. find() skips the prefix entirely and checks the full key at the leaf.
+//
+// Leaves hold the key and value and are tagged pointers (low bit set) in
+// the child arrays. Nodes and leaves come from per-size free lists carved
+// out of 64 KB slabs, and the slabs come from the memory_resource, so an
+// erase-heavy workload recycles its nodes instead of calling malloc. That
+// also makes a HugePageArena, whose deallocate is a no-op, a good fit.
+//
+// find() returns a pointer that stays valid until that key is erased;
+// other inserts and erases may move nodes but never leaves.
+
+template <typename Value>
+class ArtMap {
+    using Ref = uintptr_t;  // 0 = empty, low bit 1 = Leaf*, else Node*
+
+    enum Type : uint8_t { kNode4 = 1, kNode16, kNode48, kNode256 };
+
+    struct Leaf {
+        uint64_t key;  // sign bit flipped
+        Value value;
+    };
+
+    struct Node {
+        uint8_t type;
+        uint8_t depth;    // byte position this node branches on, 0 = most significant
+        uint16_t count;   // children
+        uint64_t prefix;  // any key below; bytes [0, depth) are the node's path
+    };
+    struct Node4 : Node {
+        uint8_t keys[4];
+        Ref children[4];
+    };
+    struct Node16 : Node {
+        uint8_t keys[16];
+        Ref children[16];
+    };
+    struct Node48 : Node {
+        uint8_t index[256];  // byte -> slot + 1, 0 = none
+        Ref children[48];
+    };
+    struct Node256 : Node {
+        Ref children[256];
+    };
+
+    // Fixed-size blocks with one free list per size class.
+    class Pool {
+    public:
+        static constexpr size_t kSlab = size_t{64} << 10;
+        static constexpr size_t kClasses = 5;  // Leaf, then one per node Type
+
+        explicit Pool(std::pmr::memory_resource* mr) : slabs_(mr) {}
+        ~Pool() { release(); }
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        void* allocate(size_t cls, size_t bytes) {
+            if (void* p = free_[cls]) {
+                free_[cls] = *static_cast<void**>(p);
+                return p;
+            }
+            bytes = (bytes + 15) & ~size_t{15};
+            if (bytes > left_) {
+                cur_ = static_cast<char*>(slabs_.get_allocator().resource()->allocate(kSlab, 64));
+                slabs_.push_back(cur_);
+                left_ = kSlab;
+            }
+            void* p = cur_;
+            cur_ += bytes;
+            left_ -= bytes;
+            return p;
+        }
+
+        void deallocate(size_t cls, void* p) {
+            *static_cast<void**>(p) = free_[cls];
+            free_[cls] = p;
+        }
+
+        // Returns every slab to the memory_resource.
+        void release() {
+            for (void* s : slabs_) slabs_.get_allocator().resource()->deallocate(s, kSlab, 64);
+            slabs_.clear();
+            std::fill(std::begin(free_), std::end(free_), nullptr);
+            cur_ = nullptr;
+            left_ = 0;
+        }
+
+        size_t bytes() const { return slabs_.size() * kSlab; }
+
+    private:
+        std::pmr::vector<char*> slabs_;
+        void* free_[kClasses] = {};
+        char* cur_ = nullptr;
+        size_t left_ = 0;
+    };
+
+    static_assert(alignof(Leaf) <= 16, "pool blocks are 16-byte aligned");
+
+public:
+    ArtMap() : ArtMap(std::pmr::get_default_resource()) {}
+    // Take node slabs from `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit ArtMap(std::pmr::memory_resource* mr) : pool_(mr) {}
+
+    ~ArtMap() { destroy_leaves(root_); }
+    ArtMap(const ArtMap&) = delete;
+    ArtMap& operator=(const ArtMap&) = delete;
+
+    // Inserts or overwrites; true if the key was new.
+    bool insert(int64_t key, Value value) {
+        const uint64_t k = bias(key);
+        Ref* slot = &root_;
+        for (;;) {
+            Ref r = *slot;
+            if (r == 0) {
+                *slot = make_leaf(k, std::move(value));
+                break;
+            }
+            if (is_leaf(r)) {
+                Leaf* l = as_leaf(r);
+                if (l->key == k) {
+                    l->value = std::move(value);
+                    return false;
+                }
+                *slot = make_pair(diff_byte(l->key, k), l->key, r, k,
+                                  make_leaf(k, std::move(value)));
+                break;
+            }
+            Node* n = as_node(r);
+            if (n->depth > 0 && ((k ^ n->prefix) >> (64 - 8 * n->depth)) != 0) {
+                // The key leaves this node's path above it: split the path.
+                *slot = make_pair(diff_byte(n->prefix, k), n->prefix, r, k,
+                                  make_leaf(k, std::move(value)));
+                break;
+            }
+            const uint8_t b = byte_at(k, n->depth);
+            Ref* child = find_child(n, b);
+            if (child == nullptr) {
+                add_child(slot, n, b, make_leaf(k, std::move(value)));
+                break;
+            }
+            slot = child;
+        }
+        ++size_;
+        return true;
+    }
+
+    const Value* find(int64_t key) const {
+        LLTI_PROBE_SCOPE(ArtFind);
+        const uint64_t k = bias(key);
+        Ref r = root_;
+        while (r != 0 && !is_leaf(r)) {
+            const Node* n = as_node(r);
+            const Ref* child = find_child(n, byte_at(k, n->depth));
+            if (child == nullptr) return nullptr;
+            r = *child;
+        }
+        if (r == 0) return nullptr;
+        const Leaf* l = as_leaf(r);
+        return l->key == k ? &l->value : nullptr;
+    }
+
+    Value* find(int64_t key) {
+        return const_cast<Value*>(static_cast<const ArtMap*>(this)->find(key));
+    }
+
+    // True if the key was present.
+    bool erase(int64_t key) {
+        const uint64_t k = bias(key);
+        Ref* slot = &root_;
+        Ref* parent_slot = nullptr;
+        for (;;) {
+            Ref r = *slot;
+            if (r == 0) return false;
+            if (is_leaf(r)) {
+                Leaf* l = as_leaf(r);
+                if (l->key != k) return false;
+                if (parent_slot == nullptr) {
+                    root_ = 0;
+                } else {
+                    Node* parent = as_node(*parent_slot);
+                    remove_child(parent_slot, parent, byte_at(k, parent->depth));
+                }
+                free_leaf(l);
+                --size_;
+                return true;
+            }
+            Node* n = as_node(r);
+            Ref* child = find_child(n, byte_at(k, n->depth));
+            if (child == nullptr) return false;
+            parent_slot = slot;
+            slot = child;
+        }
+    }
+
+    // Calls fn(key, value) for every key in [lo, hi], in key order.
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn&& fn) const {
+        if (root_ != 0 && lo <= hi) scan_ref(root_, bias(lo), bias(hi), fn);
+    }
+
+    // Calls fn(key, value) for every key, in key order.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        scan(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), fn);
+    }
+
+    void clear() {
+        destroy_leaves(root_);
+        pool_.release();
+        root_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    // Slab memory held, including free blocks awaiting reuse.
+    size_t memory_bytes() const { return pool_.bytes(); }
+
+private:
+    static uint64_t bias(int64_t key) { return static_cast<uint64_t>(key) ^ (uint64_t{1} << 63); }
+    static int64_t unbias(uint64_t k) { return static_cast<int64_t>(k ^ (uint64_t{1} << 63)); }
+    static uint8_t byte_at(uint64_t k, unsigned depth) {
+        return static_cast<uint8_t>(k >> (56 - 8 * depth));
+    }
+    // First byte position where two different keys differ.
+    static uint8_t diff_byte(uint64_t a, uint64_t b) {
+        return static_cast<uint8_t>(__builtin_clzll(a ^ b) / 8);
+    }
+
+    static bool is_leaf(Ref r) { return r & 1; }
+    static Leaf* as_leaf(Ref r) { return reinterpret_cast<Leaf*>(r & ~Ref{1}); }
+    static Node* as_node(Ref r) { return reinterpret_cast<Node*>(r); }
+
+    template <typename T>
+    static constexpr size_t size_class() {
+        if constexpr (std::is_same_v<T, Leaf>) return 0;
+        else if constexpr (std::is_same_v<T, Node4>) return kNode4;
+        else if constexpr (std::is_same_v<T, Node16>) return kNode16;
+        else if constexpr (std::is_same_v<T, Node48>) return kNode48;
+        else return kNode256;
+    }
+
+    Ref make_leaf(uint64_t k, Value value) {
+        void* p = pool_.allocate(0, sizeof(Leaf));
+        return reinterpret_cast<Ref>(new (p) Leaf{k, std::move(value)}) | 1;
+    }
+
+    void free_leaf(Leaf* l) {
+        l->~Leaf();
+        pool_.deallocate(0, l);
+    }
+
+    template <typename T>
+    T* new_node(uint8_t depth, uint64_t prefix) {
+        T* n = new (pool_.allocate(size_class<T>(), sizeof(T))) T();
+        n->type = static_cast<uint8_t>(size_class<T>());
+        n->depth = depth;
+        n->count = 0;
+        n->prefix = prefix;
+        return n;
+    }
+
+    template <typename T>
+    void free_node(T* n) {
+        pool_.deallocate(size_class<T>(), n);
+    }
+
+    // A Node4 at `depth` holding two subtrees whose keys first differ there.
+    Ref make_pair(uint8_t depth, uint64_t key_a, Ref a, uint64_t key_b, Ref b) {
+        Node4* n = new_node<Node4>(depth, key_b);
+        uint8_t byte_a = byte_at(key_a, depth), byte_b = byte_at(key_b, depth);
+        if (byte_b < byte_a) {
+            std::swap(byte_a, byte_b);
+            std::swap(a, b);
+        }
+        n->keys[0] = byte_a;
+        n->keys[1] = byte_b;
+        n->children[0] = a;
+        n->children[1] = b;
+        n->count = 2;
+        return reinterpret_cast<Ref>(n);
+    }
+
+    static const Ref* find_child(const Node* n, uint8_t b) {
+        switch (n->type) {
+            case kNode4: {
+                auto* n4 = static_cast<const Node4*>(n);
+                for (unsigned i = 0; i < n4->count; ++i)
+                    if (n4->keys[i] == b) return &n4->children[i];
+                return nullptr;
+            }
+            case kNode16: {
+                auto* n16 = static_cast<const Node16*>(n);
+#if defined(__SSE2__)
+                __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n16->keys));
+                __m128i hit = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(b)));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit)) &
+                                ((1u << n16->count) - 1);
+                return mask ? &n16->children[__builtin_ctz(mask)] : nullptr;
+#else
+                for (unsigned i = 0; i < n16->count; ++i)
+                    if (n16->keys[i] == b) return &n16->children[i];
+                return nullptr;
+#endif
+            }
+            case kNode48: {
+                auto* n48 = static_cast<const Node48*>(n);
+                unsigned slot = n48->index[b];
+                return slot ? &n48->children[slot - 1] : nullptr;
+            }
+            default: {
+                auto* n256 = static_cast<const Node256*>(n);
+                return n256->children[b] ? &n256->children[b] : nullptr;
+            }
+        }
+    }
+
+    static Ref* find_child(Node* n, uint8_t b) {
+        return const_cast<Ref*>(find_child(static_cast<const Node*>(n), b));
+    }
+
+    // Inserts into a sorted keys/children pair of arrays with room left.
+    template <typename T>
+    static void insert_sorted(T* n, uint8_t b, Ref child) {
+        unsigned pos = 0;
+        while (pos < n->count && n->keys[pos] < b) ++pos;
+        std::memmove(n->keys + pos + 1, n->keys + pos, n->count - pos);
+        std::memmove(n->children + pos + 1, n->children + pos, (n->count - pos) * sizeof(Ref));
+        n->keys[pos] = b;
+        n->children[pos] = child;
+        ++n->count;
+    }
+
+    template <typename From, typename To>
+    To* replace(Ref* slot, From* old) {
+        To* n = new_node<To>(old->depth, old->prefix);
+        *slot = reinterpret_cast<Ref>(n);
+        return n;
+    }
+
+    // Adds a child for byte b (not present), growing the node if it is full.
+    void add_child(Ref* slot, Node* n, uint8_t b, Ref child) {
+        switch (n->type) {
+            case kNode4: {
+                auto* n4 = static_cast<Node4*>(n);
+                if (n4->count < 4) return insert_sorted(n4, b, child);
+                auto* grown = replace<Node4, Node16>(slot, n4);
+                std::memcpy(grown->keys, n4->keys, 4);
+                std::memcpy(grown->children, n4->children, 4 * sizeof(Ref));
+                grown->count = 4;
+                free_node(n4);
+                return insert_sorted(grown, b, child);
+            }
+            case kNode16: {
+                auto* n16 = static_cast<Node16*>(n);
+                if (n16->count < 16) return insert_sorted(n16, b, child);
+                auto* grown = replace<Node16, Node48>(slot, n16);
+                for (unsigned i = 0; i < 16; ++i) {
+                    grown->index[n16->keys[i]] = static_cast<uint8_t>(i + 1);
+                    grown->children[i] = n16->children[i];
+                }
+                grown->count = 16;
+                free_node(n16);
+                return add_child(slot, grown, b, child);
+            }
+            case kNode48: {
+                auto* n48 = static_cast<Node48*>(n);
+                if (n48->count < 48) {
+                    unsigned slot48 = 0;
+                    while (n48->children[slot48] != 0) ++slot48;
+                    n48->children[slot48] = child;
+                    n48->index[b] = static_cast<uint8_t>(slot48 + 1);
+                    ++n48->count;
+                    return;
+                }
+                auto* grown = replace<Node48, Node256>(slot, n48);
+                for (unsigned c = 0; c < 256; ++c)
+                    if (n48->index[c]) grown->children[c] = n48->children[n48->index[c] - 1];
+                grown->count = 48;
+                free_node(n48);
+                return add_child(slot, grown, b, child);
+            }
+            default: {
+                auto* n256 = static_cast<Node256*>(n);
+                n256->children[b] = child;
+                ++n256->count;
+                return;
+            }
+        }
+    }
+
+    // Removes the child for byte b, shrinking the node once it is well
+    // under the smaller type's capacity (so alternating insert/erase at a
+    // boundary does not reallocate every time). A Node4 left with one
+    // child is replaced by that child; its depth is absolute, so nothing
+    // else changes.
+    void remove_child(Ref* slot, Node* n, uint8_t b) {
+        switch (n->type) {
+            case kNode4: {
+                auto* n4 = static_cast<Node4*>(n);
+                remove_sorted(n4, b);
+                if (n4->count == 1) {
+                    *slot = n4->children[0];
+                    free_node(n4);
+                }
+                return;
+            }
+            case kNode16: {
+                auto* n16 = static_cast<Node16*>(n);
+                remove_sorted(n16, b);
+                if (n16->count > 3) return;
+                auto* shrunk = replace<Node16, Node4>(slot, n16);
+                std::memcpy(shrunk->keys, n16->keys, n16->count);
+                std::memcpy(shrunk->children, n16->children, n16->count * sizeof(Ref));
+                shrunk->count = n16->count;
+                free_node(n16);
+                return;
+            }
+            case kNode48: {
+                auto* n48 = static_cast<Node48*>(n);
+                n48->children[n48->index[b] - 1] = 0;
+                n48->index[b] = 0;
+                if (--n48->count > 12) return;
+                auto* shrunk = replace<Node48, Node16>(slot, n48);
+                for (unsigned c = 0; c < 256; ++c) {
+                    if (!n48->index[c]) continue;
+                    shrunk->keys[shrunk->count] = static_cast<uint8_t>(c);
+                    shrunk->children[shrunk->count++] = n48->children[n48->index[c] - 1];
+                }
+                free_node(n48);
+                return;
+            }
+            default: {
+                auto* n256 = static_cast<Node256*>(n);
+                n256->children[b] = 0;
+                if (--n256->count > 37) return;
+                auto* shrunk = replace<Node256, Node48>(slot, n256);
+                for (unsigned c = 0; c < 256; ++c) {
+                    if (!n256->children[c]) continue;
+                    shrunk->children[shrunk->count] = n256->children[c];
+                    shrunk->index[c] = static_cast<uint8_t>(++shrunk->count);
+                }
+                free_node(n256);
+                return;
+            }
+        }
+    }
+
+    template <typename T>
+    static void remove_sorted(T* n, uint8_t b) {
+        unsigned pos = 0;
+        while (n->keys[pos] != b) ++pos;
+        std::memmove(n->keys + pos, n->keys + pos + 1, n->count - pos - 1);
+        std::memmove(n->children + pos, n->children + pos + 1, (n->count - pos - 1) * sizeof(Ref));
+        --n->count;
+    }
+
+    // Visits r's subtree in order, skipping children whose key range lies
+    // outside [lo, hi] (biased keys). Returns false once past hi.
+    template <typename Fn>
+    static bool scan_ref(Ref r, uint64_t lo, uint64_t hi, Fn& fn) {
+        if (is_leaf(r)) {
+            const Leaf* l = as_leaf(r);
+            if (l->key > hi) return false;
+            if (l->key >= lo) fn(unbias(l->key), l->value);
+            return true;
+        }
+        const Node* n = as_node(r);
+        const unsigned shift = 56 - 8 * n->depth;
+        const uint64_t path = n->depth == 0 ? 0 : n->prefix & ~(~uint64_t{0} >> (8 * n->depth));
+        // Returns false to stop the whole scan.
+        auto visit = [&](unsigned b, Ref child) {
+            uint64_t first = path | (uint64_t{b} << shift);
+            uint64_t last = first | ((uint64_t{1} << shift) - 1);
+            if (first > hi) return false;
+            if (last < lo) return true;
+            return scan_ref(child, lo, hi, fn);
+        };
+        switch (n->type) {
+            case kNode4:
+            case kNode16: {
+                const uint8_t* keys = n->type == kNode4 ? static_cast<const Node4*>(n)->keys
+                                                        : static_cast<const Node16*>(n)->keys;
+                const Ref* children = n->type == kNode4 ? static_cast<const Node4*>(n)->children
+                                                        : static_cast<const Node16*>(n)->children;
+                for (unsigned i = 0; i < n->count; ++i)
+                    if (!visit(keys[i], children[i])) return false;
+                return true;
+            }
+            case kNode48: {
+                auto* n48 = static_cast<const Node48*>(n);
+                for (unsigned c = start_byte(path, n->depth, lo); c < 256; ++c)
+                    if (n48->index[c] && !visit(c, n48->children[n48->index[c] - 1])) return false;
+                return true;
+            }
+            default: {
+                auto* n256 = static_cast<const Node256*>(n);
+                for (unsigned c = start_byte(path, n->depth, lo); c < 256; ++c)
+                    if (n256->children[c] && !visit(c, n256->children[c])) return false;
+                return true;
+            }
+        }
+    }
+
+    // First byte worth visiting in a wide node: lo's byte if lo falls in
+    // this node's range, else 0.
+    static unsigned start_byte(uint64_t path, unsigned depth, uint64_t lo) {
+        bool same_path = depth == 0 || ((lo ^ path) >> (64 - 8 * depth)) == 0;
+        return same_path ? byte_at(lo, depth) : 0;
+    }
+
+    void destroy_leaves(Ref r) {
+        if (std::is_trivially_destructible_v<Value> || r == 0) return;
+        if (is_leaf(r)) {
+            as_leaf(r)->~Leaf();
+            return;
+        }
+        scan_children(as_node(r), [this](Ref child) { destroy_leaves(child); });
+    }
+
+    template <typename Fn>
+    static void scan_children(const Node* n, Fn&& fn) {
+        switch (n->type) {
+            case kNode4: {
+                auto* n4 = static_cast<const Node4*>(n);
+                for (unsigned i = 0; i < n4->count; ++i) fn(n4->children[i]);
+                return;
+            }
+            case kNode16: {
+                auto* n16 = static_cast<const Node16*>(n);
+                for (unsigned i = 0; i < n16->count; ++i) fn(n16->children[i]);
+                return;
+            }
+            case kNode48: {
+                auto* n48 = static_cast<const Node48*>(n);
+                for (unsigned s = 0; s < 48; ++s)
+                    if (n48->children[s]) fn(n48->children[s]);
+                return;
+            }
+            default: {
+                auto* n256 = static_cast<const Node256*>(n);
+                for (unsigned c = 0; c < 256; ++c)
+                    if (n256->children[c]) fn(n256->children[c]);
+                return;
+            }
+        }
+    }
+
+    Pool pool_;
+    Ref root_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace llti
@@ -0,0 +1,95 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "llti/eytzinger_lookup.h"
+#include "llti/probe.h"
+
+namespace llti {
+
+// Static temporal lookup: (key, time) -> the value of `key` as of `time`,
+// meaning the version with the greatest timestamp <= time.
+//
+// Versions are sorted by (key, time) and stored in two flat arrays,
+// `times` and `vals`, so each key's history is one contiguous run. An
+// EytzingerLookup maps each distinct key to its rank, and `runs[rank]` and
+// `runs[rank + 1]` bound that key's run. An as-of query is therefore one
+// branchless tree descent plus a branchless upper_bound over the run. The
+// run is usually a line or two of timestamps, so it adds roughly one cache
+// miss on top of a plain find.
+//
+// A (key, time) pair given twice keeps the last value, the same as a
+// replayed update stream.
+
+template <typename Value>
+struct AsOfLookup {
+    struct Version {
+        int64_t key;
+        int64_t time;
+        Value value;
+    };
+
+    EytzingerLookup<uint64_t> index;   // key -> rank
+    std::pmr::vector<uint64_t> runs;   // runs[rank] .. runs[rank + 1] in times/vals
+    std::pmr::vector<int64_t> times;
+    std::pmr::vector<Value> vals;
+
+    AsOfLookup() = default;
+    // Place every array in `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit AsOfLookup(std::pmr::memory_resource* mr) : index(mr), runs(mr), times(mr), vals(mr) {}
+
+    void build(std::vector<Version> versions) {
+        std::stable_sort(versions.begin(), versions.end(), [](const Version& a, const Version& b) {
+            return a.key != b.key ? a.key < b.key : a.time < b.time;
+        });
+        runs.clear();
+        times.clear();
+        vals.clear();
+        times.reserve(versions.size());
+        vals.reserve(versions.size());
+
+        std::vector<std::pair<int64_t, uint64_t>> ranks;
+        for (size_t i = 0; i < versions.size(); ++i) {
+            const Version& v = versions[i];
+            bool new_key = ranks.empty() || versions[i - 1].key != v.key;
+            if (new_key) {
+                ranks.push_back({v.key, ranks.size()});
+                runs.push_back(times.size());
+            } else if (versions[i - 1].time == v.time) {
+                vals.back() = std::move(versions[i].value);  // same instant: last wins
+                continue;
+            }
+            times.push_back(v.time);
+            vals.push_back(std::move(versions[i].value));
+        }
+        runs.push_back(times.size());
+        index.build(std::move(ranks));
+    }
+
+    // Value of `key` as of `time`, or nullptr if the key is unknown or its
+    // first version is later than `time`.
+    const Value* find(int64_t key, int64_t time) const {
+        LLTI_PROBE_SCOPE(AsOfFind);
+        const uint64_t* rank = index.find(key);
+        if (!rank) return nullptr;
+        const int64_t* first = times.data() + runs[*rank];
+        size_t len = runs[*rank + 1] - runs[*rank];  // >= 1
+        // Branchless upper_bound over the run, as in binary search elsewhere.
+        while (len > 1) {
+            size_t half = len / 2;
+            first = (first[half - 1] <= time) ? first + half : first;
+            len -= half;
+        }
+        size_t end = static_cast<size_t>(first - times.data()) + (*first <= time);
+        if (end == runs[*rank]) return nullptr;  // every version is later
+        return &vals[end - 1];
+    }
+
+    size_t num_keys() const { return index.n; }
+    size_t num_versions() const { return times.size(); }
+};
+
+} // namespace llti
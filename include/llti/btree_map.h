@@ -0,0 +1,438 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "llti/probe.h"
+#include "llti/sorted_lookup.h"
+
+namespace llti {
+
+// Mutable in-memory B+tree over int64 keys, the dynamic counterpart to
+// the static layouts: SortedLookup's search, but with O(log n) inserts and
+// erases instead of a rebuild.
+//
+// Inner nodes and leaves hold 32 keys each in one 64-byte-aligned array of
+// four cache lines. Unused slots hold INT64_MAX, so the in-node search is
+// a fixed eight AVX2 compares with no dependence on the node's count: a
+// leaf's position is the number of keys below the target, an inner node's
+// child the number of separators at or below it. Children and values sit
+// in a parallel array, so a descent reads the key lines plus one line per
+// level for the pointer. Every node is a whole number of cache lines
+// (sizeof is a multiple of 64).
+//
+// Leaves are linked both ways, so scan() is one descent followed by a walk
+// along the leaf chain.
+//
+// Leaves split in half, except that a key appended past the end of the
+// rightmost leaf starts a new leaf: ascending IDs then fill leaves
+// completely instead of leaving them half empty. Erase uses
+// free-at-empty: a leaf is removed only once its last key goes, with no
+// merging or borrowing. Under mixed inserts and erases this keeps
+// utilization close to merge-at-half while never restructuring on the
+// erase path (Johnson and Shasha, "B-trees with inserts and deletes: why
+// free-at-empty is better than merge-at-half").
+//
+// bulk_load builds the tree bottom-up from sorted keys (e.g. a
+// SortedLookup's arrays) in O(n), filling nodes to 3/4 so the first
+// inserts after a load do not all split.
+//
+// Value must be trivially copyable: values move within and between
+// leaves with memmove. Nodes come from the memory_resource given at
+// construction.
+
+template <typename Value>
+class BTreeMap {
+    static_assert(std::is_trivially_copyable_v<Value>, "leaf values are moved with memmove");
+
+public:
+    static constexpr unsigned kNodeKeys = 32;
+
+private:
+    static constexpr int64_t kEmpty = std::numeric_limits<int64_t>::max();
+    static constexpr unsigned kBulkFill = kNodeKeys * 3 / 4;  // keys per leaf, children per inner
+    static constexpr unsigned kMaxHeight = 16;
+
+    struct alignas(64) Leaf {
+        int64_t keys[kNodeKeys];
+        Value vals[kNodeKeys];
+        Leaf* prev;
+        Leaf* next;
+        uint32_t count;
+    };
+
+    struct alignas(64) Inner {
+        int64_t keys[kNodeKeys];  // keys[i] = smallest key under children[i + 1]
+        void* children[kNodeKeys + 1];
+        uint32_t count;  // keys; count + 1 children
+    };
+
+    static_assert(sizeof(Leaf) % 64 == 0 && sizeof(Inner) % 64 == 0, "whole cache lines");
+
+public:
+    BTreeMap() : BTreeMap(std::pmr::get_default_resource()) {}
+    // Allocate nodes from `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit BTreeMap(std::pmr::memory_resource* mr) : mr_(mr) {}
+
+    ~BTreeMap() { clear(); }
+    BTreeMap(const BTreeMap&) = delete;
+    BTreeMap& operator=(const BTreeMap&) = delete;
+
+    const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(BTreeFind);
+        if (root_ == nullptr) return nullptr;
+        const Leaf* leaf = find_leaf(target);
+        unsigned pos = count_less(leaf->keys, target);
+        return pos < leaf->count && leaf->keys[pos] == target ? &leaf->vals[pos] : nullptr;
+    }
+
+    Value* find(int64_t target) {
+        return const_cast<Value*>(static_cast<const BTreeMap*>(this)->find(target));
+    }
+
+    // Inserts or overwrites; true if the key was new.
+    bool insert(int64_t key, const Value& value) {
+        if (root_ == nullptr) {
+            Leaf* leaf = new_leaf();
+            leaf_insert(leaf, 0, key, value);
+            root_ = first_ = leaf;
+            size_ = 1;
+            return true;
+        }
+        Inner* path[kMaxHeight];
+        unsigned slots[kMaxHeight];
+        Leaf* leaf = descend(key, path, slots);
+        unsigned pos = count_less(leaf->keys, key);
+        if (pos < leaf->count && leaf->keys[pos] == key) {
+            leaf->vals[pos] = value;
+            return false;
+        }
+        ++size_;
+        if (leaf->count < kNodeKeys) {
+            leaf_insert(leaf, pos, key, value);
+            return true;
+        }
+
+        // Split the leaf; an append past the rightmost key starts a new one.
+        Leaf* right = new_leaf();
+        unsigned split = pos == kNodeKeys && leaf->next == nullptr ? kNodeKeys : kNodeKeys / 2;
+        right->count = kNodeKeys - split;
+        std::memcpy(right->keys, leaf->keys + split, right->count * sizeof(int64_t));
+        std::memcpy(right->vals, leaf->vals + split, right->count * sizeof(Value));
+        std::fill(leaf->keys + split, leaf->keys + kNodeKeys, kEmpty);
+        leaf->count = split;
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr) leaf->next->prev = right;
+        leaf->next = right;
+        if (pos < split || (pos == split && split < kNodeKeys))
+            leaf_insert(leaf, pos, key, value);
+        else
+            leaf_insert(right, pos - split, key, value);
+
+        // Push the new separator up, splitting full inner nodes on the way.
+        int64_t sep = right->keys[0];
+        void* child = right;
+        for (unsigned h = height_; h-- > 0;) {
+            Inner* in = path[h];
+            if (in->count < kNodeKeys) {
+                inner_insert(in, slots[h], sep, child);
+                return true;
+            }
+            int64_t keys[kNodeKeys + 1];
+            void* children[kNodeKeys + 2];
+            const unsigned c = slots[h];
+            std::copy(in->keys, in->keys + c, keys);
+            keys[c] = sep;
+            std::copy(in->keys + c, in->keys + kNodeKeys, keys + c + 1);
+            std::copy(in->children, in->children + c + 1, children);
+            children[c + 1] = child;
+            std::copy(in->children + c + 1, in->children + kNodeKeys + 1, children + c + 2);
+
+            // Left keeps keys [0, mid), keys[mid] moves up, right takes the rest.
+            constexpr unsigned mid = (kNodeKeys + 1) / 2;
+            Inner* r = new_inner();
+            set_inner(in, keys, children, mid);
+            set_inner(r, keys + mid + 1, children + mid + 1, kNodeKeys - mid);
+            sep = keys[mid];
+            child = r;
+        }
+        Inner* root = new_inner();
+        root->keys[0] = sep;
+        root->children[0] = root_;
+        root->children[1] = child;
+        root->count = 1;
+        root_ = root;
+        ++height_;
+        return true;
+    }
+
+    // True if the key was present.
+    bool erase(int64_t key) {
+        if (root_ == nullptr) return false;
+        Inner* path[kMaxHeight];
+        unsigned slots[kMaxHeight];
+        Leaf* leaf = descend(key, path, slots);
+        unsigned pos = count_less(leaf->keys, key);
+        if (pos >= leaf->count || leaf->keys[pos] != key) return false;
+        --size_;
+        std::memmove(leaf->keys + pos, leaf->keys + pos + 1,
+                     (leaf->count - pos - 1) * sizeof(int64_t));
+        std::memmove(leaf->vals + pos, leaf->vals + pos + 1,
+                     (leaf->count - pos - 1) * sizeof(Value));
+        leaf->keys[--leaf->count] = kEmpty;
+        if (leaf->count > 0) return true;
+
+        // Free-at-empty: unlink the leaf, then drop it from its parent,
+        // freeing any parent left without children on the way up.
+        if (leaf->prev != nullptr) leaf->prev->next = leaf->next;
+        else first_ = leaf->next;
+        if (leaf->next != nullptr) leaf->next->prev = leaf->prev;
+        free_node(leaf);
+        unsigned h = height_;
+        while (h-- > 0 && path[h]->count == 0) free_node(path[h]);
+        if (h == static_cast<unsigned>(-1)) {
+            root_ = nullptr;
+            height_ = 0;
+            return true;
+        }
+        inner_remove(path[h], slots[h]);
+
+        // A root with one child is replaced by that child.
+        while (height_ > 0 && static_cast<Inner*>(root_)->count == 0) {
+            Inner* old = static_cast<Inner*>(root_);
+            root_ = old->children[0];
+            free_node(old);
+            --height_;
+        }
+        return true;
+    }
+
+    // Calls fn(key, value) for every key in [lo, hi], in key order.
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn&& fn) const {
+        if (root_ == nullptr || lo > hi) return;
+        const Leaf* leaf = find_leaf(lo);
+        unsigned pos = count_less(leaf->keys, lo);
+        for (; leaf != nullptr; leaf = leaf->next, pos = 0) {
+            for (; pos < leaf->count; ++pos) {
+                if (leaf->keys[pos] > hi) return;
+                fn(leaf->keys[pos], leaf->vals[pos]);
+            }
+        }
+    }
+
+    // Calls fn(key, value) for every key, in key order.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const Leaf* leaf = first_; leaf != nullptr; leaf = leaf->next)
+            for (unsigned pos = 0; pos < leaf->count; ++pos) fn(leaf->keys[pos], leaf->vals[pos]);
+    }
+
+    // Replaces the contents with n entries sorted by key. Of equal keys
+    // the first is kept, the one SortedLookup::find returns.
+    void bulk_load(const int64_t* keys, const Value* vals, size_t n) {
+        clear();
+        size_t unique = 0;
+        for (size_t i = 0; i < n; ++i) unique += i == 0 || keys[i] != keys[i - 1];
+        if (unique == 0) return;
+
+        // Leaves, with the smallest key of each for the separators above.
+        std::vector<std::pair<void*, int64_t>> level;
+        const size_t leaves = (unique + kBulkFill - 1) / kBulkFill;
+        Leaf* prev = nullptr;
+        size_t i = 0;
+        for (size_t l = 0; l < leaves; ++l) {
+            Leaf* leaf = new_leaf();
+            const size_t take = unique / leaves + (l < unique % leaves);
+            while (leaf->count < take) {
+                if (i == 0 || keys[i] != keys[i - 1]) {
+                    leaf->keys[leaf->count] = keys[i];
+                    leaf->vals[leaf->count++] = vals[i];
+                }
+                ++i;
+            }
+            leaf->prev = prev;
+            if (prev != nullptr) prev->next = leaf;
+            else first_ = leaf;
+            prev = leaf;
+            level.push_back({leaf, leaf->keys[0]});
+        }
+
+        // Inner levels until one node remains.
+        while (level.size() > 1) {
+            std::vector<std::pair<void*, int64_t>> parents;
+            const size_t groups = (level.size() + kBulkFill - 1) / kBulkFill;
+            size_t c = 0;
+            for (size_t g = 0; g < groups; ++g) {
+                const size_t take = level.size() / groups + (g < level.size() % groups);
+                Inner* in = new_inner();
+                for (size_t k = 0; k < take; ++k, ++c) {
+                    in->children[k] = level[c].first;
+                    if (k > 0) in->keys[k - 1] = level[c].second;
+                }
+                in->count = static_cast<uint32_t>(take - 1);
+                parents.push_back({in, level[c - take].second});
+            }
+            level = std::move(parents);
+            ++height_;
+        }
+        root_ = level[0].first;
+        size_ = unique;
+    }
+
+    void bulk_load(const SortedLookup<Value>& sorted) {
+        bulk_load(sorted.keys.data(), sorted.vals.data(), sorted.keys.size());
+    }
+
+    void clear() {
+        if (root_ != nullptr) free_subtree(root_, height_);
+        root_ = nullptr;
+        first_ = nullptr;
+        height_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    // Inner levels above the leaves.
+    unsigned height() const { return height_; }
+
+private:
+    // Keys in the 32-slot array that are < target. Empty slots hold
+    // INT64_MAX, which is never below a target.
+    static unsigned count_less(const int64_t* keys, int64_t target) {
+#if defined(__AVX2__)
+        const __m256i t = _mm256_set1_epi64x(target);
+        unsigned n = 0;
+        for (unsigned i = 0; i < kNodeKeys; i += 4) {
+            __m256i k = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+            __m256d less = _mm256_castsi256_pd(_mm256_cmpgt_epi64(t, k));
+            n += __builtin_popcount(_mm256_movemask_pd(less));
+        }
+        return n;
+#else
+        unsigned n = 0;
+        for (unsigned i = 0; i < kNodeKeys; ++i) n += keys[i] < target;
+        return n;
+#endif
+    }
+
+    // Child of `in` whose range holds target: separators <= target. Empty
+    // slots count only when target is INT64_MAX, hence the clamp.
+    static unsigned child_index(const Inner* in, int64_t target) {
+#if defined(__AVX2__)
+        const __m256i t = _mm256_set1_epi64x(target);
+        unsigned greater = 0;
+        for (unsigned i = 0; i < kNodeKeys; i += 4) {
+            __m256i k = _mm256_load_si256(reinterpret_cast<const __m256i*>(in->keys + i));
+            __m256d above = _mm256_castsi256_pd(_mm256_cmpgt_epi64(k, t));
+            greater += __builtin_popcount(_mm256_movemask_pd(above));
+        }
+        return std::min(kNodeKeys - greater, in->count);
+#else
+        unsigned n = 0;
+        for (unsigned i = 0; i < kNodeKeys; ++i) n += in->keys[i] <= target;
+        return std::min(n, in->count);
+#endif
+    }
+
+    const Leaf* find_leaf(int64_t target) const {
+        const void* node = root_;
+        for (unsigned h = height_; h > 0; --h) {
+            const Inner* in = static_cast<const Inner*>(node);
+            node = in->children[child_index(in, target)];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    // find_leaf, recording the inner nodes and child slots taken.
+    Leaf* descend(int64_t target, Inner** path, unsigned* slots) {
+        void* node = root_;
+        for (unsigned h = 0; h < height_; ++h) {
+            Inner* in = static_cast<Inner*>(node);
+            slots[h] = child_index(in, target);
+            path[h] = in;
+            node = in->children[slots[h]];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    static void leaf_insert(Leaf* leaf, unsigned pos, int64_t key, const Value& value) {
+        std::memmove(leaf->keys + pos + 1, leaf->keys + pos, (leaf->count - pos) * sizeof(int64_t));
+        std::memmove(leaf->vals + pos + 1, leaf->vals + pos, (leaf->count - pos) * sizeof(Value));
+        leaf->keys[pos] = key;
+        leaf->vals[pos] = value;
+        ++leaf->count;
+    }
+
+    // Adds separator `key` with `child` to its right, next to child slot c.
+    static void inner_insert(Inner* in, unsigned c, int64_t key, void* child) {
+        std::memmove(in->keys + c + 1, in->keys + c, (in->count - c) * sizeof(int64_t));
+        std::memmove(in->children + c + 2, in->children + c + 1, (in->count - c) * sizeof(void*));
+        in->keys[c] = key;
+        in->children[c + 1] = child;
+        ++in->count;
+    }
+
+    // Removes child slot c and one separator next to it. Dropping child 0
+    // drops keys[0]: the next child inherits the range, which holds no keys
+    // of the removed child.
+    static void inner_remove(Inner* in, unsigned c) {
+        unsigned k = c == 0 ? 0 : c - 1;
+        std::memmove(in->keys + k, in->keys + k + 1, (in->count - k - 1) * sizeof(int64_t));
+        std::memmove(in->children + c, in->children + c + 1, (in->count - c) * sizeof(void*));
+        in->keys[--in->count] = kEmpty;
+    }
+
+    static void set_inner(Inner* in, const int64_t* keys, void* const* children, unsigned count) {
+        std::copy(keys, keys + count, in->keys);
+        std::fill(in->keys + count, in->keys + kNodeKeys, kEmpty);
+        std::copy(children, children + count + 1, in->children);
+        in->count = count;
+    }
+
+    Leaf* new_leaf() {
+        Leaf* leaf = static_cast<Leaf*>(mr_->allocate(sizeof(Leaf), alignof(Leaf)));
+        std::fill(leaf->keys, leaf->keys + kNodeKeys, kEmpty);
+        leaf->prev = leaf->next = nullptr;
+        leaf->count = 0;
+        return leaf;
+    }
+
+    Inner* new_inner() {
+        Inner* in = static_cast<Inner*>(mr_->allocate(sizeof(Inner), alignof(Inner)));
+        std::fill(in->keys, in->keys + kNodeKeys, kEmpty);
+        in->count = 0;
+        return in;
+    }
+
+    void free_node(Leaf* leaf) { mr_->deallocate(leaf, sizeof(Leaf), alignof(Leaf)); }
+    void free_node(Inner* in) { mr_->deallocate(in, sizeof(Inner), alignof(Inner)); }
+
+    void free_subtree(void* node, unsigned height) {
+        if (height == 0) return free_node(static_cast<Leaf*>(node));
+        Inner* in = static_cast<Inner*>(node);
+        for (unsigned c = 0; c <= in->count; ++c) free_subtree(in->children[c], height - 1);
+        free_node(in);
+    }
+
+    std::pmr::memory_resource* mr_;
+    void* root_ = nullptr;
+    Leaf* first_ = nullptr;
+    unsigned height_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace llti
@@ -0,0 +1,262 @@
+#pragma once
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "llti/topology.h"
+
+namespace llti {
+
+// Memory hierarchy calibration: what does a dependent load cost on this host?
+//
+// Lookup latency is only interpretable against the machine's own numbers:
+// 65 ns for Eytzinger means "mostly L3 hits" on one host and "two DRAM
+// misses" on another. The suite measures
+//   - dependent-load latency via a random pointer chase (one pointer per
+//     cache line, Sattolo cycle so every line is visited) at working sets
+//     from 4 KB upward, once with 4 KB pages and once with THP,
+//   - TLB reach: the largest working set where 4 KB pages cost no more
+//     than huge pages (beyond it every step adds a page walk),
+//   - streaming read/write bandwidth.
+// The expected_misses() model then turns cache sizes into a per-layout
+// prediction of how many lines each lookup has to fetch from each level.
+
+// Anonymous mapping aligned to 2 MB so THP can back it when asked.
+class ChaseBuffer {
+public:
+    static constexpr size_t kLine = 64;
+    static constexpr size_t kHugePage = size_t{2} << 20;
+
+    ChaseBuffer(size_t bytes, bool huge_pages, uint64_t seed = 1)
+        : lines_(std::max<size_t>(bytes / kLine, 2)) {
+        size_t len = lines_ * kLine;
+        map_len_ = ((len + kHugePage - 1) / kHugePage + 1) * kHugePage;
+        void* p = mmap(nullptr, map_len_, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        map_ = p;
+        auto addr = reinterpret_cast<uintptr_t>(p);
+        base_ = reinterpret_cast<char*>((addr + kHugePage - 1) & ~(kHugePage - 1));
+        madvise(base_, len, huge_pages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+
+        // Sattolo's algorithm: a uniformly random single cycle over all lines,
+        // so the chase cannot fall into a short loop that stays cache-resident.
+        std::vector<uint32_t> order(lines_);
+        for (size_t i = 0; i < lines_; ++i) order[i] = static_cast<uint32_t>(i);
+        std::mt19937_64 rng(seed);
+        for (size_t i = lines_ - 1; i > 0; --i) {
+            std::uniform_int_distribution<size_t> dist(0, i - 1);
+            std::swap(order[i], order[dist(rng)]);
+        }
+        for (size_t i = 0; i < lines_; ++i)
+            *reinterpret_cast<void**>(base_ + i * kLine) = base_ + order[i] * kLine;
+    }
+
+    ~ChaseBuffer() { munmap(map_, map_len_); }
+    ChaseBuffer(const ChaseBuffer&) = delete;
+    ChaseBuffer& operator=(const ChaseBuffer&) = delete;
+
+    size_t lines() const { return lines_; }
+    void* head() const { return base_; }
+
+    // Average nanoseconds per dependent load over `steps` hops.
+    double chase_ns(size_t steps) const {
+        void* p = base_;
+        // One warm-up lap (capped) so first-touch page faults are not timed.
+        for (size_t i = 0, warm = std::min(lines_, steps); i < warm; ++i)
+            p = *static_cast<void**>(p);
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < steps; ++i) p = *static_cast<void**>(p);
+        auto t1 = std::chrono::steady_clock::now();
+        sink_ = p;
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / steps;
+    }
+
+private:
+    size_t lines_;
+    size_t map_len_ = 0;
+    void* map_ = nullptr;
+    char* base_ = nullptr;
+    mutable void* volatile sink_ = nullptr;
+};
+
+// Read and write bandwidth over a buffer larger than the LLC.
+struct Bandwidth {
+    double read_gbs = 0.0;
+    double write_gbs = 0.0;
+};
+
+inline Bandwidth measure_bandwidth(size_t bytes, int passes = 3) {
+    size_t words = std::max<size_t>(bytes / sizeof(uint64_t), 1024);
+    std::vector<uint64_t> buf(words, 1);
+    Bandwidth bw;
+    for (int pass = 0; pass < passes; ++pass) {
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (size_t i = 0; i + 4 <= words; i += 4) {
+            s0 += buf[i];
+            s1 += buf[i + 1];
+            s2 += buf[i + 2];
+            s3 += buf[i + 3];
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        volatile uint64_t sink = s0 + s1 + s2 + s3;
+        (void)sink;
+        std::memset(buf.data(), pass, words * sizeof(uint64_t));
+        auto t2 = std::chrono::steady_clock::now();
+        double gb = words * sizeof(uint64_t) / 1e9;
+        bw.read_gbs = std::max(bw.read_gbs, gb / std::chrono::duration<double>(t1 - t0).count());
+        bw.write_gbs = std::max(bw.write_gbs, gb / std::chrono::duration<double>(t2 - t1).count());
+    }
+    return bw;
+}
+
+struct LatencyPoint {
+    size_t bytes = 0;
+    double ns_4k = 0.0;    // 4 KB pages (MADV_NOHUGEPAGE)
+    double ns_huge = 0.0;  // transparent huge pages (MADV_HUGEPAGE)
+};
+
+struct MemoryCalibration {
+    size_t l1_bytes = 0;
+    size_t l2_bytes = 0;
+    size_t l3_bytes = 0;
+    std::vector<LatencyPoint> curve;
+    double l1_ns = 0.0;
+    double l2_ns = 0.0;
+    double l3_ns = 0.0;
+    double dram_ns = 0.0;     // largest working set, huge pages (no page walks)
+    double dram_4k_ns = 0.0;  // same working set with 4 KB pages
+    size_t tlb_reach_bytes = 0;
+    Bandwidth bandwidth;
+
+    // Chase working sets from 4 KB to `max_bytes` (doubling). Cache sizes
+    // come from sysfs; hosts that hide them get 32K/1M/32M defaults.
+    static MemoryCalibration run(const Topology& topo, size_t max_bytes,
+                                 size_t steps = size_t{1} << 20) {
+        MemoryCalibration cal;
+        cal.l1_bytes = topo.l1d_bytes ? topo.l1d_bytes : size_t{32} << 10;
+        cal.l2_bytes = topo.l2_bytes ? topo.l2_bytes : size_t{1} << 20;
+        cal.l3_bytes = topo.l3_bytes ? topo.l3_bytes : size_t{32} << 20;
+
+        for (size_t bytes = size_t{4} << 10; bytes <= max_bytes; bytes *= 2) {
+            LatencyPoint pt;
+            pt.bytes = bytes;
+            pt.ns_4k = ChaseBuffer(bytes, false).chase_ns(steps);
+            pt.ns_huge = ChaseBuffer(bytes, true).chase_ns(steps);
+            cal.curve.push_back(pt);
+        }
+        if (cal.curve.empty()) return cal;
+
+        // Representative latency for a level: the largest working set that
+        // comfortably fits (half the capacity, leaving room for the code,
+        // stack and the other ways' conflict misses).
+        auto at = [&](size_t limit) {
+            const LatencyPoint* best = &cal.curve.front();
+            for (const auto& pt : cal.curve)
+                if (pt.bytes <= limit) best = &pt;
+            return best->ns_huge;
+        };
+        cal.l1_ns = at(cal.l1_bytes / 2);
+        cal.l2_ns = at(cal.l2_bytes / 2);
+        cal.l3_ns = at(cal.l3_bytes / 2);
+        cal.dram_ns = cal.curve.back().ns_huge;
+        cal.dram_4k_ns = cal.curve.back().ns_4k;
+
+        // TLB reach: the working set after which 4 KB pages stay >10% slower
+        // than huge pages for every larger set. Requiring the gap to persist
+        // (and to exceed 1 ns) keeps single noisy points from tripping it.
+        auto walks = [](const LatencyPoint& pt) {
+            return pt.ns_4k > 1.10 * pt.ns_huge && pt.ns_4k - pt.ns_huge > 1.0;
+        };
+        size_t first = cal.curve.size();
+        while (first > 0 && walks(cal.curve[first - 1])) --first;
+        if (first == cal.curve.size()) cal.tlb_reach_bytes = cal.curve.back().bytes;
+        else cal.tlb_reach_bytes = first > 0 ? cal.curve[first - 1].bytes : 0;
+
+        cal.bandwidth = measure_bandwidth(std::min(max_bytes, std::max(4 * cal.l3_bytes,
+                                                                       size_t{256} << 20)));
+        return cal;
+    }
+
+    // First-order latency prediction from expected_misses() counts:
+    // every miss out of level k is charged the latency of level k+1.
+    // Ignores overlap from prefetch and out-of-order execution, so it is
+    // an upper bound for the prefetching layouts.
+    double predict_ns(double miss_l1, double miss_l2, double miss_l3) const {
+        return (miss_l1 - miss_l2) * l2_ns + (miss_l2 - miss_l3) * l3_ns + miss_l3 * dram_ns;
+    }
+};
+
+enum class SearchLayout { Sorted, Eytzinger, Veb };
+
+// Expected cache lines a successful lookup of a uniformly random key must
+// fetch from beyond a cache of `cache_bytes`, for n int64 keys.
+//
+// Model: a search visits one node per tree depth d = 0..D-1. Under uniform
+// queries, shallow depths are touched exponentially more often than deep
+// ones, so an LRU cache holds the top depths whose combined footprint fits.
+// Each deeper depth costs one miss per distinct line it touches:
+//   Sorted:    depth d's 2^d midpoints sit on distinct lines until the
+//              probe spacing drops below 8 keys (the last 3 probes share
+//              a line), so footprint is 64 B per node.
+//   Eytzinger: depth d is 2^d contiguous 8-byte keys; every depth >= 3
+//              touches a new line.
+//   vEB:       16-byte nodes; a line holds a height-2 subtree, so below
+//              the cached depths a line is crossed every other depth.
+// Value loads are excluded; the lookup benchmarks never dereference them.
+inline double expected_misses(SearchLayout layout, size_t n, size_t cache_bytes) {
+    if (n == 0) return 0.0;
+    const int depth = 64 - __builtin_clzll(n);  // ceil(log2(n + 1))
+    const double lines_total = std::ceil(n * (layout == SearchLayout::Veb ? 16.0 : 8.0) / 64.0);
+
+    double footprint = 0.0;
+    double misses = 0.0;
+    int cached_depth = depth;
+    for (int d = 0; d < depth; ++d) {
+        double nodes = std::ldexp(1.0, d);
+        double level_bytes = 0.0;
+        switch (layout) {
+            case SearchLayout::Sorted:
+                level_bytes = std::min(nodes * 64.0, lines_total * 64.0);
+                break;
+            case SearchLayout::Eytzinger:
+                level_bytes = std::max(64.0, nodes * 8.0);
+                break;
+            case SearchLayout::Veb:
+                level_bytes = std::max(64.0, nodes * 16.0);
+                break;
+        }
+        footprint += level_bytes;
+        if (footprint > static_cast<double>(cache_bytes)) {
+            cached_depth = d;
+            break;
+        }
+    }
+
+    int uncached = depth - cached_depth;
+    switch (layout) {
+        case SearchLayout::Sorted:
+            misses = std::max(0, uncached - 3);
+            break;
+        case SearchLayout::Eytzinger:
+            misses = uncached;
+            break;
+        case SearchLayout::Veb:
+            misses = std::ceil(uncached / 2.0);
+            break;
+    }
+    return misses;
+}
+
+} // namespace llti
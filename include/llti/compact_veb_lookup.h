@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+#include "llti/probe.h"
+
+namespace llti {
+
+// vEB layout without VebLookup's 4-billion-entry limit.
+//
+// VebLookup stores absolute uint32 child indices. Here each child link is
+// the child's distance from its parent instead. In the vEB order a child
+// always follows its parent, and a child in the same recursive block is
+// close, so nearly every offset is small. Only links that cross from a top
+// tree into a distant bottom tree get large; an offset that does not fit
+// the link's OffsetBits-1 bits instead names a slot in `far`, which holds
+// the child's absolute 64-bit position. Nodes stay 16 bytes at any n.
+//
+// Far links are not rare at scale. At 5B keys (height 33) the outermost
+// split leaves a 17-level top tree, and most of the ~2^17 links from its
+// bottom level into the bottom trees span more than 2^31 nodes: 87K far
+// links, 680 KB of `far`, all at depth 16. About two lookups in three
+// then pay one extra dependent load from L2 or L3 at that depth.
+// veb_scale_benchmark emulates this on 10M keys with 23-bit links.
+//
+// The positions match VebLookup's layout, but the build needs no O(n)
+// index temporaries. One recursive pass over the vEB order links each node
+// from its already-placed parent. It keeps only the leaf positions of the
+// current top tree, which is O(sqrt n), in one buffer per recursion level
+// reused across calls. A second in-order walk over the links then fills
+// keys and values from the sorted entries.
+//
+// OffsetBits < 32 only exists so tests can force far links on small trees.
+
+template <typename Value, unsigned OffsetBits = 32>
+struct CompactVebLookup {
+    static_assert(OffsetBits >= 2 && OffsetBits <= 32, "links are uint32");
+    static constexpr uint32_t kNear = uint32_t{1} << (OffsetBits - 1);  // links >= kNear are far
+
+    struct alignas(16) SearchData {
+        int64_t key;
+        uint32_t children[2];  // 0 = none, < kNear = offset, else kNear + far index
+    };
+
+    std::pmr::vector<SearchData> tree;  // 1-indexed, tree[1] is the root
+    std::pmr::vector<Value> vals;
+    std::pmr::vector<uint64_t> far;
+    size_t n = 0;
+
+    CompactVebLookup() = default;
+    // Place tree, vals and far in `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit CompactVebLookup(std::pmr::memory_resource* mr) : tree(mr), vals(mr), far(mr) {}
+
+    void build(std::vector<std::pair<int64_t, Value>> entries) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        n = entries.size();
+        tree.clear();
+        vals.clear();
+        far.clear();
+        if (n == 0) return;
+
+        tree.assign(n + 1, SearchData{0, {0, 0}});
+        vals.resize(n + 1);
+        next_pos_ = 0;
+        // One top-leaf buffer per recursion level; heights halve, so 64
+        // levels of tree need six.
+        std::vector<uint64_t> scratch[8];
+        layout(1, 64 - __builtin_clzll(n), 0, 0, nullptr, scratch);
+
+        // In-order walk over the links hands out the sorted entries.
+        std::vector<uint64_t> stack;
+        size_t sorted_idx = 0;
+        uint64_t curr = 1;
+        while (curr != 0 || !stack.empty()) {
+            while (curr != 0) {
+                stack.push_back(curr);
+                curr = child(curr, 0);
+            }
+            curr = stack.back();
+            stack.pop_back();
+            tree[curr].key = entries[sorted_idx].first;
+            vals[curr] = std::move(entries[sorted_idx].second);
+            ++sorted_idx;
+            curr = child(curr, 1);
+        }
+    }
+
+    const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(CompactVebFind);
+        if (n == 0) return nullptr;
+
+        const SearchData* candidate = far.empty() ? descend<false>(target) : descend<true>(target);
+        if (candidate != nullptr && candidate->key == target) return &vals[candidate - tree.data()];
+        return nullptr;
+    }
+
+private:
+    // Branchless descent returning the last node with key >= target. A
+    // tree without far links (any n below 2^31) is walked without the far
+    // check, keeping the loop as short as VebLookup's.
+    template <bool kHasFar>
+    const SearchData* descend(int64_t target) const {
+        // Walk with a node pointer so a near link is one add, as in VebLookup.
+        const SearchData* base = tree.data();
+        const SearchData* node = base + 1;
+        const SearchData* candidate = nullptr;
+        for (;;) {
+            // Masking keeps the prefetch branch-free; for a far link it
+            // just touches a harmless nearby line.
+            __builtin_prefetch(node + (node->children[0] & (kNear - 1)));
+            __builtin_prefetch(node + (node->children[1] & (kNear - 1)));
+            int64_t key = node->key;
+            candidate = (target <= key) ? node : candidate;  // CMOV
+            uint32_t link = node->children[key < target];     // branchless select
+            if (link == 0) return candidate;
+            if (kHasFar && __builtin_expect(link >= kNear, 0))
+                node = base + far[link - kNear];
+            else
+                node += link;
+        }
+    }
+
+    uint64_t child(uint64_t pos, int side) const {
+        uint32_t link = tree[pos].children[side];
+        if (link == 0) return 0;
+        return link < kNear ? pos + link : far[link - kNear];
+    }
+
+    void link(uint64_t parent, int side, uint64_t pos) {
+        if (parent == 0) return;
+        uint64_t offset = pos - parent;
+        if (offset < kNear) {
+            tree[parent].children[side] = static_cast<uint32_t>(offset);
+            return;
+        }
+        if (far.size() >= uint64_t{UINT32_MAX} - kNear + 1)
+            throw std::overflow_error("CompactVebLookup: too many far links");
+        tree[parent].children[side] = static_cast<uint32_t>(kNear + far.size());
+        far.push_back(pos);
+    }
+
+    // Places the subtree of height h rooted at BFS index `root` in vEB
+    // order (the same recursion as VebLookup::build_veb_complete), linking
+    // its root from `parent`. With `leaves` set, appends the positions of
+    // the subtree's bottom-level nodes in BFS order. scratch[0] holds this
+    // call's top leaves; deeper calls use scratch + 1.
+    void layout(size_t root, int h, uint64_t parent, int side, std::vector<uint64_t>* leaves,
+                std::vector<uint64_t>* scratch) {
+        if (h == 0 || root > n) return;
+        if (h == 1) {
+            uint64_t pos = ++next_pos_;
+            link(parent, side, pos);
+            if (leaves) leaves->push_back(pos);
+            return;
+        }
+        int bottom_h = h / 2;
+        int top_h = h - bottom_h;
+
+        std::vector<uint64_t>& top_leaves = scratch[0];
+        top_leaves.clear();
+        layout(root, top_h, parent, side, &top_leaves, scratch + 1);
+
+        size_t first = root << top_h;
+        size_t num_bottom = size_t{1} << top_h;
+        for (size_t i = 0; i < num_bottom && first + i <= n; ++i)
+            layout(first + i, bottom_h, top_leaves[i / 2], static_cast<int>(i & 1), leaves,
+                   scratch + 1);
+    }
+
+    uint64_t next_pos_ = 0;
+};
+
+} // namespace llti
@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace llti {
+
+// Linear merge of a table's existing entries with a small delta, shared by
+// the layouts' rebuild_with.
+//
+// The delta is sorted once (O(d log d) for d changed keys), then the
+// layout feeds its current entries in key order through operator() and
+// finish() returns the merged, sorted sequence. That is one O(n + d) pass
+// instead of build()'s O(n log n) sort of all n pairs.
+//
+// Deletes remove every existing entry with that key. An upsert replaces
+// every existing entry with its key by one entry, or inserts it. A key
+// both deleted and upserted ends up with the upserted value, and a key
+// upserted twice keeps the last value given.
+template <typename Value>
+class DeltaMerge {
+public:
+    DeltaMerge(std::vector<std::pair<int64_t, Value>> upserts, std::vector<int64_t> deletes,
+               size_t existing)
+        : upserts_(std::move(upserts)), deletes_(std::move(deletes)) {
+        std::stable_sort(upserts_.begin(), upserts_.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        // Keep the last upsert of each key.
+        auto last = std::unique(upserts_.rbegin(), upserts_.rend(),
+                                [](const auto& a, const auto& b) { return a.first == b.first; });
+        upserts_.erase(upserts_.begin(), last.base());
+        std::sort(deletes_.begin(), deletes_.end());
+        out_.reserve(existing + upserts_.size());
+    }
+
+    // Next existing entry; keys must arrive in non-decreasing order. The
+    // value is moved from if it survives.
+    void operator()(int64_t key, Value& value) {
+        while (u_ < upserts_.size() && upserts_[u_].first < key)
+            out_.push_back(std::move(upserts_[u_++]));
+        while (d_ < deletes_.size() && deletes_[d_] < key) ++d_;
+
+        if (u_ < upserts_.size() && upserts_[u_].first == key) {
+            out_.push_back(std::move(upserts_[u_++]));
+            replaced_ = true;
+            return;
+        }
+        if (replaced_ && out_.back().first == key) return;  // duplicate of an upserted key
+        replaced_ = false;
+        if (d_ < deletes_.size() && deletes_[d_] == key) return;
+        out_.emplace_back(key, std::move(value));
+    }
+
+    // The merged entries, sorted by key.
+    std::vector<std::pair<int64_t, Value>> finish() {
+        while (u_ < upserts_.size()) out_.push_back(std::move(upserts_[u_++]));
+        return std::move(out_);
+    }
+
+private:
+    std::vector<std::pair<int64_t, Value>> upserts_;
+    std::vector<int64_t> deletes_;
+    std::vector<std::pair<int64_t, Value>> out_;
+    size_t u_ = 0;
+    size_t d_ = 0;
+    bool replaced_ = false;  // out_.back() is an upsert that replaced existing entries
+};
+
+} // namespace llti
@@ -0,0 +1,126 @@
+#pragma once
+#include <sched.h>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llti/topology.h"
+#include "llti/tsc.h"
+
+namespace llti {
+
+// Run-time snapshot of the conditions a benchmark actually ran under.
+//
+// benchmark_c7i.sh sets up isolation and the governor from the outside,
+// but a forgotten reboot or a wrapper that drops affinity silently turns a
+// 65 ns result into a 90 ns one. Probing from inside the binary, on the
+// CPU we are pinned to, lets every result carry its own provenance and
+// lets the run refuse to produce numbers that are not comparable.
+//
+// Fields read from sysfs are "" when the kernel does not export them
+// (VMs without cpufreq, non-Intel turbo drivers); "" never warns.
+
+struct BenchEnvironment {
+    int cpu = -1;
+    std::string cpu_model;
+    std::string governor;   // scaling_governor of `cpu`
+    std::string turbo;      // "on", "off" or ""
+    std::string thp;        // active transparent_hugepage mode
+    bool isolated = false;  // `cpu` is in isolcpus
+    bool nohz_full = false; // `cpu` is in nohz_full
+    bool invariant_tsc = false;
+    double tsc_hz = 0.0;
+
+    // Probe the current CPU (or `cpu` if given). Measures the TSC for
+    // ~20 ms, so call it once at startup, after pinning.
+    static BenchEnvironment probe(const Topology& topo, int cpu = -1,
+                                  const std::string& sys_root = "/sys",
+                                  const std::string& proc_root = "/proc") {
+        BenchEnvironment env;
+        env.cpu = cpu >= 0 ? cpu : sched_getcpu();
+
+        std::string flags;
+        std::istringstream cpuinfo(read_sysfs(proc_root + "/cpuinfo"));
+        for (std::string line; std::getline(cpuinfo, line);) {
+            auto colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            std::string key = line.substr(0, line.find_last_not_of(" \t", colon - 1) + 1);
+            std::string value = colon + 2 <= line.size() ? line.substr(colon + 2) : "";
+            if (key == "model name" && env.cpu_model.empty()) env.cpu_model = value;
+            if (key == "flags" && flags.empty()) flags = " " + value + " ";
+            if (!env.cpu_model.empty() && !flags.empty()) break;
+        }
+        env.invariant_tsc = flags.find(" constant_tsc ") != std::string::npos &&
+                            flags.find(" nonstop_tsc ") != std::string::npos;
+
+        const std::string cpu_root = sys_root + "/devices/system/cpu";
+        env.governor = read_sysfs(cpu_root + "/cpu" + std::to_string(env.cpu) +
+                                  "/cpufreq/scaling_governor");
+
+        // intel_pstate exposes no_turbo (1 = turbo disabled); acpi-cpufreq
+        // exposes cpufreq/boost (1 = turbo enabled).
+        std::string no_turbo = read_sysfs(cpu_root + "/intel_pstate/no_turbo");
+        std::string boost = read_sysfs(cpu_root + "/cpufreq/boost");
+        if (!no_turbo.empty()) env.turbo = no_turbo == "1" ? "off" : "on";
+        else if (!boost.empty()) env.turbo = boost == "1" ? "on" : "off";
+
+        env.thp = bracketed(read_sysfs(sys_root + "/kernel/mm/transparent_hugepage/enabled"));
+
+        if (const CpuInfo* info = topo.cpu(env.cpu)) {
+            env.isolated = info->isolated;
+            env.nohz_full = info->nohz_full;
+        }
+        env.tsc_hz = measure_tsc_hz();
+        return env;
+    }
+
+    // Conditions that make latency numbers incomparable with the c7i
+    // reference runs in benchmark_tests/benchmarks.md.
+    std::vector<std::string> warnings() const {
+        std::vector<std::string> w;
+        if (!isolated)
+            w.push_back("CPU " + std::to_string(cpu) + " is not in isolcpus");
+        if (!nohz_full)
+            w.push_back("CPU " + std::to_string(cpu) + " is not in nohz_full (scheduler tick active)");
+        if (!governor.empty() && governor != "performance")
+            w.push_back("cpufreq governor is '" + governor + "', not 'performance'");
+        if (turbo == "on")
+            w.push_back("turbo is enabled; frequency depends on package load and temperature");
+        if (thp == "always")
+            w.push_back("transparent_hugepage=always; khugepaged compaction adds jitter");
+        if (!invariant_tsc)
+            w.push_back("TSC is not invariant (constant_tsc/nonstop_tsc missing)");
+        return w;
+    }
+
+    // Key/value pairs for benchmark::AddCustomContext and result files.
+    std::vector<std::pair<std::string, std::string>> context() const {
+        char tsc[32];
+        std::snprintf(tsc, sizeof(tsc), "%.3f", tsc_hz / 1e9);
+        return {
+            {"llti_cpu", std::to_string(cpu)},
+            {"llti_cpu_model", cpu_model.empty() ? "unknown" : cpu_model},
+            {"llti_governor", governor.empty() ? "unknown" : governor},
+            {"llti_turbo", turbo.empty() ? "unknown" : turbo},
+            {"llti_thp", thp.empty() ? "unknown" : thp},
+            {"llti_isolated", isolated ? "yes" : "no"},
+            {"llti_nohz_full", nohz_full ? "yes" : "no"},
+            {"llti_invariant_tsc", invariant_tsc ? "yes" : "no"},
+            {"llti_tsc_ghz", tsc},
+        };
+    }
+
+private:
+    // "always [madvise] never" -> "madvise"
+    static std::string bracketed(const std::string& s) {
+        auto open = s.find('[');
+        auto close = s.find(']', open);
+        if (open == std::string::npos || close == std::string::npos) return s;
+        return s.substr(open + 1, close - open - 1);
+    }
+};
+
+} // namespace llti
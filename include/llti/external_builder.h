@@ -0,0 +1,412 @@
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llti/eytzinger_lookup.h"
+#include "llti/probe.h"
+
+namespace llti {
+
+// Builds an Eytzinger table from an unsorted binary file larger than RAM,
+// straight into an mmap-able output file.
+//
+// The input is a packed array of Record<Value> {key, value}. The build is
+// an external merge sort in bounded memory:
+//   1. Run generation: read memory_budget / 2 bytes of records at a time,
+//      LSD radix sort them on the key with the other half as scratch, and
+//      write each sorted chunk to a run file.
+//   2. k-way merge: one large read buffer per run and a min-heap of run
+//      heads yield all records in key order.
+//   3. Layout: an in-order walk of the implicit tree gives each sorted
+//      record its Eytzinger position. Within one level of the tree the
+//      in-order walk visits positions left to right, so the output is
+//      written as one sequential, buffered stream per level (keys and
+//      values separately) rather than as random writes.
+//
+// The output file is a 64-byte-aligned header followed by the 1-indexed
+// key and value arrays at the offsets it records; EytzingerFile maps it
+// and searches it in place. Duplicate keys are kept, as in build().
+//
+// Only the Eytzinger layout is written this way. vEB and B-tree layouts
+// place each sorted record by a recursive block structure rather than per
+// level, so they would not reduce to a few sequential streams.
+
+template <typename Value>
+struct Record {
+    int64_t key;
+    Value value;
+};
+
+struct ExternalBuildOptions {
+    size_t memory_budget = size_t{256} << 20;  // bytes of buffers the build may hold
+    std::string temp_dir;                      // for run files; default: the output's directory
+};
+
+struct ExternalBuildStats {
+    uint64_t records = 0;
+    size_t runs = 0;
+    uint64_t bytes_read = 0;     // input plus runs
+    uint64_t bytes_written = 0;  // runs plus output
+};
+
+namespace external_detail {
+
+constexpr uint64_t kMagic = 0x4c4c544945595a46ULL;  // "LLTIEYZF"
+
+struct FileHeader {
+    uint64_t magic;
+    uint64_t n;
+    uint64_t value_size;
+    uint64_t keys_offset;
+    uint64_t vals_offset;
+    uint64_t bytes;
+};
+
+[[noreturn]] inline void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+class File {
+public:
+    File(const std::string& path, int flags) : path_(path) {
+        fd_ = open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd_ < 0) throw_errno("open " + path);
+    }
+    ~File() {
+        if (fd_ >= 0) close(fd_);
+    }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    int fd() const { return fd_; }
+
+    uint64_t size() const {
+        struct stat st;
+        if (fstat(fd_, &st) != 0) throw_errno("fstat " + path_);
+        return static_cast<uint64_t>(st.st_size);
+    }
+
+    // Reads up to `bytes` from `offset`; fewer only at end of file.
+    size_t read_at(void* buf, size_t bytes, uint64_t offset) const {
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t r = pread(fd_, static_cast<char*>(buf) + done, bytes - done,
+                              static_cast<off_t>(offset + done));
+            if (r < 0 && errno == EINTR) continue;
+            if (r < 0) throw_errno("read " + path_);
+            if (r == 0) break;
+            done += static_cast<size_t>(r);
+        }
+        return done;
+    }
+
+    void write_at(const void* buf, size_t bytes, uint64_t offset) const {
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t w = pwrite(fd_, static_cast<const char*>(buf) + done, bytes - done,
+                               static_cast<off_t>(offset + done));
+            if (w < 0 && errno == EINTR) continue;
+            if (w < 0) throw_errno("write " + path_);
+            done += static_cast<size_t>(w);
+        }
+    }
+
+private:
+    std::string path_;
+    int fd_ = -1;
+};
+
+// LSD radix sort of records by key, with `scratch` as the other buffer.
+// Keys are biased to unsigned so the digits sort signed order. One pass
+// counts every digit position up front; a position where all keys share
+// the digit is skipped. 16-bit digits measured faster than 8-bit ones:
+// each scatter pass streams the whole run through memory, and four
+// passes beat eight even with 64K scatter targets.
+template <typename Value>
+void radix_sort(Record<Value>* data, Record<Value>* scratch, size_t count) {
+    constexpr int kBits = 16;
+    constexpr int kPasses = 64 / kBits;
+    constexpr size_t kBuckets = size_t{1} << kBits;
+    if (count == 0) return;
+    auto biased = [](const Record<Value>& r) {
+        return static_cast<uint64_t>(r.key) ^ (uint64_t{1} << 63);
+    };
+    std::vector<size_t> counts(kPasses * kBuckets);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t u = biased(data[i]);
+        for (int pass = 0; pass < kPasses; ++pass)
+            ++counts[pass * kBuckets + ((u >> (pass * kBits)) & (kBuckets - 1))];
+    }
+    Record<Value>* from = data;
+    Record<Value>* to = scratch;
+    const uint64_t first = biased(data[0]);
+    for (int pass = 0; pass < kPasses; ++pass) {
+        size_t* c = &counts[pass * kBuckets];
+        if (c[(first >> (pass * kBits)) & (kBuckets - 1)] == count) continue;
+        size_t sum = 0;
+        for (size_t b = 0; b < kBuckets; ++b) sum += std::exchange(c[b], sum);
+        for (size_t i = 0; i < count; ++i)
+            to[c[(biased(from[i]) >> (pass * kBits)) & (kBuckets - 1)]++] = from[i];
+        std::swap(from, to);
+    }
+    if (from != data) std::memcpy(data, from, count * sizeof(Record<Value>));
+}
+
+// Buffered sequential reader over one sorted run.
+template <typename Value>
+class RunReader {
+public:
+    RunReader(const std::string& path, size_t buffer_records)
+        : file_(path, O_RDONLY), buf_(std::max<size_t>(buffer_records, 1)) {
+        size_ = file_.size() / sizeof(Record<Value>);
+        refill();
+    }
+
+    bool done() const { return pos_ == len_; }
+    const Record<Value>& head() const { return buf_[pos_]; }
+    void pop() {
+        if (++pos_ == len_) refill();
+    }
+    uint64_t bytes_read() const { return next_ * sizeof(Record<Value>); }
+
+private:
+    void refill() {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(buf_.size(), size_ - next_));
+        size_t got = file_.read_at(buf_.data(), want * sizeof(Record<Value>),
+                                   next_ * sizeof(Record<Value>));
+        len_ = got / sizeof(Record<Value>);
+        next_ += len_;
+        pos_ = 0;
+    }
+
+    File file_;
+    std::vector<Record<Value>> buf_;
+    uint64_t size_ = 0;
+    uint64_t next_ = 0;  // records consumed from the file
+    size_t pos_ = 0;
+    size_t len_ = 0;
+};
+
+// Buffered sequential writer for one tree level of one array. A level is
+// the contiguous range of positions [2^d, 2^(d+1)).
+template <typename T>
+class LevelWriter {
+public:
+    LevelWriter(const File& file, uint64_t array_offset, uint64_t first_pos, size_t buffer_elems)
+        : file_(file), next_offset_(array_offset + first_pos * sizeof(T)) {
+        buf_.reserve(std::max<size_t>(buffer_elems, 1));
+    }
+
+    void push(const T& v) {
+        buf_.push_back(v);
+        if (buf_.size() == buf_.capacity()) flush();
+    }
+
+    void flush() {
+        if (buf_.empty()) return;
+        file_.write_at(buf_.data(), buf_.size() * sizeof(T), next_offset_);
+        next_offset_ += buf_.size() * sizeof(T);
+        bytes_ += buf_.size() * sizeof(T);
+        buf_.clear();
+    }
+
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    const File& file_;
+    uint64_t next_offset_;
+    uint64_t bytes_ = 0;
+    std::vector<T> buf_;
+};
+
+inline uint64_t align64(uint64_t offset) { return (offset + 63) & ~uint64_t{63}; }
+
+// Run files, unlinked when the build finishes or throws.
+struct TempFiles {
+    std::vector<std::string> paths;
+    TempFiles() = default;
+    TempFiles(const TempFiles&) = delete;
+    TempFiles& operator=(const TempFiles&) = delete;
+    ~TempFiles() {
+        for (const auto& path : paths) unlink(path.c_str());
+    }
+};
+
+inline std::string directory_of(const std::string& path) {
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? "." : path.substr(0, slash);
+}
+
+}  // namespace external_detail
+
+// Sorts `input` (a file of Record<Value>) in options.memory_budget bytes
+// of buffers and writes the Eytzinger file to `output`.
+template <typename Value>
+ExternalBuildStats build_eytzinger_file(const std::string& input, const std::string& output,
+                                        const ExternalBuildOptions& options = {}) {
+    static_assert(std::is_trivially_copyable_v<Value>, "records are read and written as raw bytes");
+    using namespace external_detail;
+    using Rec = Record<Value>;
+
+    ExternalBuildStats stats;
+    File in(input, O_RDONLY);
+    const uint64_t n = in.size() / sizeof(Rec);
+    stats.records = n;
+    const std::string temp_dir = options.temp_dir.empty() ? directory_of(output) : options.temp_dir;
+    const size_t budget_records = std::max<size_t>(options.memory_budget / sizeof(Rec), 4);
+
+    // 1. Sorted runs of half the budget each (the other half is scratch).
+    TempFiles temp;
+    std::vector<std::string>& runs = temp.paths;
+    {
+        const size_t run_records = budget_records / 2;
+        std::vector<Rec> data(static_cast<size_t>(std::min<uint64_t>(run_records, n)));
+        std::vector<Rec> scratch(data.size());
+        for (uint64_t start = 0; start < n; start += run_records) {
+            size_t count = static_cast<size_t>(std::min<uint64_t>(run_records, n - start));
+            size_t got = in.read_at(data.data(), count * sizeof(Rec), start * sizeof(Rec));
+            if (got != count * sizeof(Rec))
+                throw std::runtime_error("build_eytzinger_file: " + input + " shrank while read");
+            stats.bytes_read += got;
+            radix_sort(data.data(), scratch.data(), count);
+
+            std::string path = temp_dir + "/llti-run-" + std::to_string(getpid()) + "-" +
+                               std::to_string(runs.size());
+            File run(path, O_CREAT | O_TRUNC | O_WRONLY);
+            runs.push_back(path);
+            run.write_at(data.data(), count * sizeof(Rec), 0);
+            stats.bytes_written += count * sizeof(Rec);
+        }
+    }
+    stats.runs = runs.size();
+
+    // 2 + 3. Merge the runs and stream each record to its tree position.
+    FileHeader header{};
+    header.magic = kMagic;
+    header.n = n;
+    header.value_size = sizeof(Value);
+    header.keys_offset = align64(sizeof(FileHeader));
+    header.vals_offset = align64(header.keys_offset + (n + 1) * sizeof(int64_t));
+    header.bytes = align64(header.vals_offset + (n + 1) * sizeof(Value));
+
+    File out(output, O_CREAT | O_TRUNC | O_RDWR);
+    if (ftruncate(out.fd(), static_cast<off_t>(header.bytes)) != 0)
+        throw_errno("ftruncate " + output);
+    out.write_at(&header, sizeof(header), 0);
+
+    if (n > 0) {
+        // Half the budget for run buffers, half for the level writers.
+        const int levels = 64 - __builtin_clzll(n);
+        const size_t per_run = std::max<size_t>(budget_records / 2 / runs.size(), 1);
+        const size_t per_level = std::max<size_t>(options.memory_budget / 2 / levels /
+                                                      (sizeof(int64_t) + sizeof(Value)),
+                                                  1);
+
+        std::vector<std::unique_ptr<RunReader<Value>>> readers;
+        for (const auto& path : runs)
+            readers.push_back(std::make_unique<RunReader<Value>>(path, per_run));
+        std::vector<LevelWriter<int64_t>> key_writers;
+        std::vector<LevelWriter<Value>> val_writers;
+        key_writers.reserve(levels);
+        val_writers.reserve(levels);
+        for (int d = 0; d < levels; ++d) {
+            key_writers.emplace_back(out, header.keys_offset, uint64_t{1} << d, per_level);
+            val_writers.emplace_back(out, header.vals_offset, uint64_t{1} << d, per_level);
+        }
+
+        using Head = std::pair<int64_t, size_t>;  // (key, run)
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+        for (size_t r = 0; r < readers.size(); ++r)
+            if (!readers[r]->done()) heap.push({readers[r]->head().key, r});
+
+        uint64_t pos = uint64_t{1} << (levels - 1);  // leftmost node
+        while (!heap.empty()) {
+            size_t r = heap.top().second;
+            heap.pop();
+            const Rec& rec = readers[r]->head();
+            int d = 63 - __builtin_clzll(pos);
+            key_writers[d].push(rec.key);
+            val_writers[d].push(rec.value);
+            readers[r]->pop();
+            if (!readers[r]->done()) heap.push({readers[r]->head().key, r});
+
+            // In-order successor, as in EytzingerLookup::rebuild_with.
+            if (2 * pos + 1 <= n) {
+                pos = 2 * pos + 1;
+                while (2 * pos <= n) pos *= 2;
+            } else {
+                pos >>= __builtin_ctzll(~pos) + 1;
+            }
+        }
+        for (int d = 0; d < levels; ++d) {
+            key_writers[d].flush();
+            val_writers[d].flush();
+            stats.bytes_written += key_writers[d].bytes() + val_writers[d].bytes();
+        }
+        for (const auto& reader : readers) stats.bytes_read += reader->bytes_read();
+    }
+    return stats;
+}
+
+// Read-only mapping of a file written by build_eytzinger_file.
+template <typename Value>
+class EytzingerFile {
+public:
+    explicit EytzingerFile(const std::string& path) {
+        external_detail::File file(path, O_RDONLY);
+        size_ = file.size();
+        if (size_ < sizeof(external_detail::FileHeader))
+            throw std::runtime_error("EytzingerFile: " + path + " is too short");
+        base_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, file.fd(), 0);
+        if (base_ == MAP_FAILED) external_detail::throw_errno("mmap " + path);
+        const auto* header = static_cast<const external_detail::FileHeader*>(base_);
+        if (header->magic != external_detail::kMagic || header->value_size != sizeof(Value) ||
+            header->bytes > size_) {
+            munmap(base_, size_);
+            throw std::runtime_error("EytzingerFile: " + path + " is not a table of this type");
+        }
+        n_ = header->n;
+        const char* bytes = static_cast<const char*>(base_);
+        keys_ = reinterpret_cast<const int64_t*>(bytes + header->keys_offset);
+        vals_ = reinterpret_cast<const Value*>(bytes + header->vals_offset);
+    }
+
+    ~EytzingerFile() { munmap(base_, size_); }
+    EytzingerFile(const EytzingerFile&) = delete;
+    EytzingerFile& operator=(const EytzingerFile&) = delete;
+
+    const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(EytzingerFileFind);
+        if (n_ == 0) return nullptr;
+        size_t i = eytzinger_search(keys_, n_, target);
+        return i != 0 ? &vals_[i] : nullptr;
+    }
+
+    size_t size() const { return n_; }
+
+private:
+    void* base_ = nullptr;
+    size_t size_ = 0;
+    size_t n_ = 0;
+    const int64_t* keys_ = nullptr;
+    const Value* vals_ = nullptr;
+};
+
+} // namespace llti
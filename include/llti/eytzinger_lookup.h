@@ -2,8 +2,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "llti/delta_merge.h"
+#include "llti/probe.h"
+
 namespace llti {
 
 // Eytzinger (BFS) layout for cache-oblivious binary search.
@@ -15,17 +23,93 @@ namespace llti {
 //
 // The search loop is branchless: i = 2*i + (keys[i] < target).
 // Software prefetch fetches the next tree level each iteration.
+//
+// find_simd descends several queries in lockstep instead: each level
+// gathers keys[i] for every lane, compares against the targets and
+// updates all indices with vector arithmetic. Levels 0..depth-2 are
+// complete, so every lane takes the same number of unmasked steps and only
+// the last, partial level needs a mask. Independent vectors interleaved in
+// one loop keep several gathers in flight, which is where the win over
+// one-at-a-time find comes from once the tree is larger than the caches.
+//
+// find_from serves streams of nearby targets: it restarts the descent from
+// an ancestor of the previous query's node whose key range holds the new
+// target, rather than from the root.
+
+// The branchless descent over a raw 1-indexed Eytzinger key array: the
+// position of `target` in keys[1..n], or 0 if it is absent. Shared by
+// EytzingerLookup::find and tables mapped from shared memory, which hold
+// offsets rather than vectors.
+inline size_t eytzinger_search(const int64_t* keys, size_t n, int64_t target) {
+    size_t i = 1;
+    while (i <= n) {
+        __builtin_prefetch(&keys[2 * i]);
+        i = 2 * i + (keys[i] < target);
+    }
+
+    // i is now past a leaf — walk back up to find the answer.
+    // After the branchless descent, the answer is at i>>(ctz(~i)+1),
+    // which undoes the trailing "go right" steps. The count is over all 64
+    // bits: past 2^32 keys a path can end in 32 or more right turns.
+    i >>= __builtin_ctzll(~i) + 1;
+    if (i > 0 && i <= n && keys[i] == target) return i;
+    return 0;
+}
 
 template <typename Value>
 struct EytzingerLookup {
     // 1-indexed: keys[0] is unused padding, tree root is keys[1]
-    std::vector<int64_t> keys;
-    std::vector<Value> vals;
+    std::pmr::vector<int64_t> keys;
+    std::pmr::vector<Value> vals;
     size_t n = 0;  // number of actual elements
 
+#if defined(__AVX512F__)
+    static constexpr size_t kSimdLanes = 8;
+#else
+    static constexpr size_t kSimdLanes = 4;
+#endif
+    // find_from restarts 4 levels above the previous query's last node
+    // (~16 keys), else 10 levels above it (~1K keys), else at the root.
+    static constexpr int kFingerNear = 4;
+    static constexpr int kFingerFar = 10;
+
+    // Where the previous find_from ended; one per query stream.
+    struct Cursor {
+        size_t node = 1;
+    };
+
+    EytzingerLookup() = default;
+    // Place keys and vals in `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit EytzingerLookup(std::pmr::memory_resource* mr) : keys(mr), vals(mr) {}
+
     void build(std::vector<std::pair<int64_t, Value>> entries) {
         std::sort(entries.begin(), entries.end(),
                   [](const auto& a, const auto& b) { return a.first < b.first; });
+        build_sorted(std::move(entries));
+    }
+
+    // Apply a small delta without re-sorting (see DeltaMerge). The current
+    // entries are read in key order by an in-order walk of the implicit
+    // tree, then the layout is refilled from the merged sequence.
+    void rebuild_with(std::vector<std::pair<int64_t, Value>> upserts, std::vector<int64_t> deletes) {
+        DeltaMerge<Value> merge(std::move(upserts), std::move(deletes), n);
+        if (n > 0) {
+            size_t i = size_t{1} << (63 - __builtin_clzll(n));  // leftmost node
+            while (i != 0) {
+                merge(keys[i], vals[i]);
+                if (2 * i + 1 <= n) {
+                    i = 2 * i + 1;
+                    while (2 * i <= n) i *= 2;
+                } else {
+                    i >>= __builtin_ctzll(~i) + 1;  // up past the right turns, as in find
+                }
+            }
+        }
+        build_sorted(merge.finish());
+    }
+
+    // build() for entries already sorted by key.
+    void build_sorted(std::vector<std::pair<int64_t, Value>> entries) {
         n = entries.size();
         if (n == 0) return;
 
@@ -38,24 +122,163 @@ struct EytzingerLookup {
     }
 
     const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(EytzingerFind);
+        if (n == 0) return nullptr;
+
+        size_t i = eytzinger_search(keys.data(), n, target);
+        return i != 0 ? &vals[i] : nullptr;
+    }
+
+    // find() starting near the cursor. Node i's subtree spans the keys
+    // between two ancestors: the nearest one it hangs left of (strip i's
+    // trailing 1s and one 0) and the nearest one it hangs right of (strip
+    // the trailing 0s and one 1). find_from checks whether the target falls
+    // inside the subtree kFingerNear, then kFingerFar, levels above the
+    // previous query's last node, and descends from the first one that
+    // holds it, over lines the previous queries left cached. Otherwise it
+    // starts at the root. The choice is made by branches, not through a
+    // data dependency on the cursor, so for a far target the predicted root
+    // descent starts without waiting for the previous query, and random
+    // streams keep find()'s overlap between lookups.
+    //
+    // Climbing to the lowest covering ancestor (true finger search) wins
+    // on strictly monotone streams, but its data-dependent hops mispredict
+    // on random walks and lose to plain find(); two fixed restart heights
+    // keep both cases ahead.
+    const Value* find_from(Cursor& cursor, int64_t target) const {
+        LLTI_PROBE_SCOPE(EytzingerFindFrom);
         if (n == 0) return nullptr;
 
-        size_t i = 1;
+        size_t last = cursor.node <= n ? cursor.node : 1;
+        size_t near = last >> kFingerNear, far = last >> kFingerFar;
+        if (near > 1 && covers(near, target)) return descend_from(cursor, near, target);
+        if (far > 1 && covers(far, target)) return descend_from(cursor, far, target);
+        return descend_from(cursor, 1, target);
+    }
+
+    // out[q] = find(targets[q]) for q in [0, count). Lanes queries share a
+    // vector register (8 needs AVX-512, 4 needs AVX2; otherwise a portable
+    // lockstep loop runs) and Vectors registers descend interleaved, so
+    // Lanes * Vectors lookups are in flight at once. A count that is not a
+    // multiple of that finishes with find().
+    template <size_t Lanes = kSimdLanes, size_t Vectors = 2>
+    void find_simd(const int64_t* targets, const Value** out, size_t count) const {
+        static_assert(Lanes == 4 || Lanes == 8, "find_simd lanes must be 4 or 8");
+        LLTI_PROBE_SCOPE(EytzingerFindSimd);
+        constexpr size_t kGroup = Lanes * Vectors;
+        size_t q = 0;
+        if (n > 0) {
+            const int depth = 64 - __builtin_clzll(n);  // levels in the tree
+            uint64_t idx[kGroup];
+            for (; q + kGroup <= count; q += kGroup) {
+                descend<Lanes, Vectors>(targets + q, idx, depth);
+                for (size_t j = 0; j < kGroup; ++j) out[q + j] = resolve(idx[j], targets[q + j]);
+            }
+        }
+        for (; q < count; ++q) out[q] = find(targets[q]);
+    }
+
+private:
+    // Undo the trailing right turns of a finished descent (see find).
+    const Value* resolve(uint64_t i, int64_t target) const {
+        i >>= __builtin_ctzll(~i) + 1;
+        if (i > 0 && i <= n && keys[i] == target) return &vals[i];
+        return nullptr;
+    }
+
+    // Whether target lies in node i's key range (see find_from); an
+    // ancestor index of 0 means that side is unbounded.
+    bool covers(size_t i, int64_t target) const {
+        size_t upper = i >> (__builtin_ctzll(~i) + 1);
+        size_t lower = i >> (__builtin_ctzll(i) + 1);
+        return (upper == 0 || target <= keys[upper]) && (lower == 0 || keys[lower] < target);
+    }
+
+    const Value* descend_from(Cursor& cursor, size_t i, int64_t target) const {
         while (i <= n) {
             __builtin_prefetch(&keys[2 * i]);
             i = 2 * i + (keys[i] < target);
         }
+        cursor.node = i >> 1;  // last node visited
+        return resolve(i, target);
+    }
 
-        // i is now past a leaf — walk back up to find the answer.
-        // After the branchless descent, the answer is at i>>ffs(~i),
-        // which undoes the last "go right" step.
-        i >>= __builtin_ffs(static_cast<int>(~i));
-        if (i > 0 && i <= n && keys[i] == target)
-            return &vals[i];
-        return nullptr;
+    // Runs Lanes * Vectors descents to completion; idx[j] ends past a leaf
+    // exactly as i does in find.
+    template <size_t Lanes, size_t Vectors>
+    void descend(const int64_t* targets, uint64_t* idx, int depth) const {
+        const int64_t* base = keys.data();
+#if defined(__AVX512F__)
+        if constexpr (Lanes == 8) {
+            const __m512i one = _mm512_set1_epi64(1);
+            const __m512i nv = _mm512_set1_epi64(static_cast<int64_t>(n));
+            // Gathers take an explicit zero source: the unmasked form leaves
+            // its source undefined, which GCC reports as -Wmaybe-uninitialized.
+            const __m512i zero = _mm512_setzero_si512();
+            __m512i t[Vectors], i[Vectors];
+            for (size_t v = 0; v < Vectors; ++v) {
+                t[v] = _mm512_loadu_si512(targets + v * 8);
+                i[v] = one;
+            }
+            for (int d = 0; d + 1 < depth; ++d) {
+                for (size_t v = 0; v < Vectors; ++v) {
+                    __m512i k = _mm512_mask_i64gather_epi64(zero, 0xFF, i[v], base, 8);
+                    __mmask8 lt = _mm512_cmplt_epi64_mask(k, t[v]);
+                    i[v] = _mm512_add_epi64(i[v], i[v]);
+                    i[v] = _mm512_mask_add_epi64(i[v], lt, i[v], one);
+                }
+            }
+            // Last level: lanes whose path already left the tree stay put.
+            for (size_t v = 0; v < Vectors; ++v) {
+                __mmask8 active = _mm512_cmple_epu64_mask(i[v], nv);
+                __m512i k = _mm512_mask_i64gather_epi64(zero, active, i[v], base, 8);
+                __mmask8 lt = _mm512_mask_cmplt_epi64_mask(active, k, t[v]);
+                i[v] = _mm512_mask_add_epi64(i[v], active, i[v], i[v]);
+                i[v] = _mm512_mask_add_epi64(i[v], lt, i[v], one);
+                _mm512_storeu_si512(idx + v * 8, i[v]);
+            }
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (Lanes == 4) {
+            using LL = long long;
+            const __m256i one = _mm256_set1_epi64x(1);
+            const __m256i n1 = _mm256_set1_epi64x(static_cast<int64_t>(n) + 1);
+            __m256i t[Vectors], i[Vectors];
+            for (size_t v = 0; v < Vectors; ++v) {
+                t[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(targets + v * 4));
+                i[v] = one;
+            }
+            for (int d = 0; d + 1 < depth; ++d) {
+                for (size_t v = 0; v < Vectors; ++v) {
+                    __m256i k = _mm256_i64gather_epi64(reinterpret_cast<const LL*>(base), i[v], 8);
+                    __m256i lt = _mm256_cmpgt_epi64(t[v], k);  // -1 where keys[i] < target
+                    i[v] = _mm256_sub_epi64(_mm256_add_epi64(i[v], i[v]), lt);
+                }
+            }
+            for (size_t v = 0; v < Vectors; ++v) {
+                __m256i active = _mm256_cmpgt_epi64(n1, i[v]);  // i <= n
+                __m256i k = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(),
+                                                        reinterpret_cast<const LL*>(base), i[v], active, 8);
+                __m256i lt = _mm256_cmpgt_epi64(t[v], k);
+                __m256i next = _mm256_sub_epi64(_mm256_add_epi64(i[v], i[v]), lt);
+                i[v] = _mm256_blendv_epi8(i[v], next, active);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(idx + v * 4), i[v]);
+            }
+            return;
+        }
+#endif
+        // Portable lockstep descent for builds without the vector ISA.
+        constexpr size_t kGroup = Lanes * Vectors;
+        for (size_t j = 0; j < kGroup; ++j) idx[j] = 1;
+        for (int d = 0; d < depth; ++d) {
+            for (size_t j = 0; j < kGroup; ++j) {
+                if (idx[j] <= n) idx[j] = 2 * idx[j] + (base[idx[j]] < targets[j]);
+            }
+        }
     }
 
-private:
     void fill_eytzinger(const std::vector<std::pair<int64_t, Value>>& sorted,
                         size_t& sorted_idx, size_t tree_idx) {
         if (tree_idx > n) return;
@@ -0,0 +1,90 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "llti/eytzinger_lookup.h"
+#include "llti/probe.h"
+
+namespace llti {
+
+// Eytzinger lookup with a small hot-key side table checked first.
+//
+// Under a skewed (Zipf-like) query mix a balanced tree spends its full
+// log2(n) depth on the few keys that take most of the queries, and most of
+// that depth is below the cache-resident top levels. build() takes a
+// per-key access weight (from a recorded trace or a sample), copies the
+// `hot_capacity` heaviest keys into a second Eytzinger table small enough
+// to stay in L1/L2, and keeps every key in the main table. A hot hit costs
+// ~log2(hot_capacity) cached probes; a cold key pays those probes on top
+// of the normal lookup, so the side table only pays off when its hit rate
+// is high; hot_weight_fraction is the hit rate the weights predict.
+//
+// The weight-balanced-tree alternative (hot keys near the root of one
+// tree) would save the double search on a miss but gives up the implicit
+// Eytzinger layout and its branchless, prefetchable descent.
+
+template <typename Value>
+struct HotKeyLookup {
+    static constexpr size_t kDefaultHotCapacity = 4096;  // 64 KB of keys + int64 values
+
+    EytzingerLookup<Value> hot;
+    EytzingerLookup<Value> main;
+    double hot_weight_fraction = 0.0;  // share of the build weights the hot table covers
+
+    HotKeyLookup() = default;
+    // Place both tables in `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit HotKeyLookup(std::pmr::memory_resource* mr) : hot(mr), main(mr) {}
+
+    // weights[i] is the access weight of entries[i]; keys with weight 0 are
+    // never hot.
+    void build(std::vector<std::pair<int64_t, Value>> entries, const std::vector<double>& weights,
+               size_t hot_capacity = kDefaultHotCapacity) {
+        if (weights.size() != entries.size())
+            throw std::invalid_argument("HotKeyLookup: one weight per entry required");
+
+        std::vector<size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        size_t k = std::min(hot_capacity, order.size());
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                          [&](size_t a, size_t b) { return weights[a] > weights[b]; });
+
+        double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+        double covered = 0.0;
+        std::vector<std::pair<int64_t, Value>> hot_entries;
+        hot_entries.reserve(k);
+        for (size_t i = 0; i < k && weights[order[i]] > 0; ++i) {
+            hot_entries.push_back(entries[order[i]]);
+            covered += weights[order[i]];
+        }
+        hot_weight_fraction = total > 0 ? covered / total : 0.0;
+
+        hot.build(std::move(hot_entries));
+        main.build(std::move(entries));
+    }
+
+    // Weights counted from a recorded trace of looked-up keys; keys in the
+    // trace that are not in entries are ignored.
+    void build_from_trace(std::vector<std::pair<int64_t, Value>> entries, std::vector<int64_t> trace,
+                          size_t hot_capacity = kDefaultHotCapacity) {
+        std::sort(trace.begin(), trace.end());
+        std::vector<double> weights(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            auto range = std::equal_range(trace.begin(), trace.end(), entries[i].first);
+            weights[i] = static_cast<double>(range.second - range.first);
+        }
+        build(std::move(entries), weights, hot_capacity);
+    }
+
+    const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(HotKeyFind);
+        if (const Value* v = hot.find(target)) return v;
+        return main.find(target);
+    }
+};
+
+} // namespace llti
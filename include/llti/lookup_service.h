@@ -0,0 +1,216 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "llti/thread_pool.h"
+#include "llti/topology.h"
+
+namespace llti {
+
+// Bounded lock-free MPMC ring (Vyukov). Each cell carries a sequence
+// number that says whose turn it is: a producer may fill cell i when
+// seq == pos, a consumer may drain it when seq == pos + 1. Head and tail
+// are claimed with a CAS, so neither side ever blocks the other and a
+// full or empty ring is reported instead of waited on.
+template <typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        cells_.reset(new Cell[cap]);
+        for (size_t i = 0; i < cap; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    bool try_push(const T& item) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = item;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& item) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = std::move(cell.item);
+                    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // empty
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T item;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<size_t> head_{0};
+};
+
+// Where a LookupService delivers one result. One slot per outstanding
+// request, owned by the client and kept alive until ready(); a slot on
+// its own cache line keeps clients from false-sharing each other's
+// completions.
+template <typename Value>
+struct alignas(64) LookupCompletion {
+    std::atomic<bool> done{false};
+    const Value* result = nullptr;
+
+    bool ready() const { return done.load(std::memory_order_acquire); }
+
+    const Value* wait() const {
+        for (unsigned attempt = 0; !ready(); ++attempt) spin_backoff(attempt);
+        return result;
+    }
+};
+
+// A lookup thread serving many clients. Clients that issue sporadic
+// lookups against a table far larger than their caches each pay a full
+// chain of dependent misses per find. Here they enqueue (key, completion
+// slot) into an MpmcRing instead. A dedicated thread, optionally pinned,
+// drains up to kBatch requests at a time and resolves them together. For a
+// table with find_simd (Eytzinger), the batch descends interleaved, so its
+// misses overlap. Then it publishes each result into its slot. Under load
+// the batch fills and throughput rises; when idle, a request waits behind
+// at most one batch.
+//
+// The table must outlive the service and must not change while it runs.
+template <class Table>
+class LookupService {
+public:
+    using Value = std::remove_cv_t<
+        std::remove_pointer_t<decltype(std::declval<const Table&>().find(int64_t{}))>>;
+    using Completion = LookupCompletion<Value>;
+    static constexpr size_t kBatch = 32;
+
+private:
+    template <class T, class = void>
+    struct has_find_simd : std::false_type {};
+    template <class T>
+    struct has_find_simd<T, std::void_t<decltype(std::declval<const T&>().find_simd(
+                                nullptr, static_cast<const Value**>(nullptr), size_t{}))>>
+        : std::true_type {};
+
+public:
+    // Whether batches descend interleaved (find_simd) or one find at a time.
+    static constexpr bool kInterleaved = has_find_simd<Table>::value;
+
+    // cpu >= 0 pins the lookup thread there.
+    explicit LookupService(const Table& table, size_t queue_capacity = 4096, int cpu = -1)
+        : table_(table), ring_(queue_capacity) {
+        thread_ = std::thread([this, cpu] {
+            if (cpu >= 0) pin_current_thread(cpu);
+            serve();
+        });
+    }
+
+    ~LookupService() {
+        stop_.store(true, std::memory_order_release);
+        thread_.join();
+    }
+
+    LookupService(const LookupService&) = delete;
+    LookupService& operator=(const LookupService&) = delete;
+
+    // Queue a lookup; false if the ring is full (the slot is untouched).
+    bool submit(int64_t key, Completion& slot) {
+        slot.done.store(false, std::memory_order_relaxed);
+        return ring_.try_push(Request{key, &slot});
+    }
+
+    // Blocking convenience: submit (retrying while full) and wait.
+    const Value* find(int64_t key) {
+        Completion slot;
+        for (unsigned attempt = 0; !submit(key, slot); ++attempt) spin_backoff(attempt);
+        return slot.wait();
+    }
+
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }
+    uint64_t served() const { return served_.load(std::memory_order_relaxed); }
+
+private:
+    struct Request {
+        int64_t key;
+        Completion* slot;
+    };
+
+    void serve() {
+        Request batch[kBatch];
+        int64_t keys[kBatch];
+        const Value* results[kBatch];
+        unsigned idle = 0;
+        for (;;) {
+            size_t count = 0;
+            while (count < kBatch && ring_.try_pop(batch[count])) ++count;
+            if (count == 0) {
+                // Drain everything queued before stop before exiting.
+                if (stop_.load(std::memory_order_acquire)) return;
+                spin_backoff(++idle);
+                continue;
+            }
+            idle = 0;
+
+            for (size_t i = 0; i < count; ++i) keys[i] = batch[i].key;
+            if constexpr (kInterleaved) {
+                table_.find_simd(keys, results, count);
+            } else {
+                for (size_t i = 0; i < count; ++i) results[i] = table_.find(keys[i]);
+            }
+            // Counted before publishing, so a client that saw its result
+            // also sees it counted.
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            served_.fetch_add(count, std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                batch[i].slot->result = results[i];
+                batch[i].slot->done.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    const Table& table_;
+    MpmcRing<Request> ring_;
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> served_{0};
+    std::thread thread_;
+};
+
+} // namespace llti
@@ -0,0 +1,272 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llti/tsc.h"
+
+namespace llti {
+
+// In-process probes for hot-path spans, in the spirit of Xpedite.
+//
+// LLTI_PROBE(Name) marks a point: it stores the TSC (and optionally a PMU
+// counter read with rdpmc) plus a pointer to the probe's name into the
+// calling thread's preallocated ring. No locks, no allocation, no system
+// calls — a probe costs one TLS load, one rdtsc and a 32-byte store.
+// LLTI_PROBE_SCOPE(Name) marks NameBegin on entry and NameEnd on every
+// exit path, which is how the lookups' find and the order book's add/cancel
+// are instrumented.
+//
+// Probes compile to nothing unless LLTI_PROBES is defined (CMake:
+// -DLLTI_ENABLE_PROBES=ON). Defining LLTI_PROBES_PMC=<ecx> additionally
+// reads that counter with rdpmc, e.g. (1 << 30) for fixed counter 0
+// (instructions retired). rdpmc faults unless user-space access is enabled
+// (echo 2 > /sys/bus/event_source/devices/cpu/rdpmc) and the counter is
+// programmed, e.g. by running under `perf stat -e instructions`.
+//
+// Rings keep the most recent samples per thread and outlive their threads.
+// After the workload quiesces, probe::dump() writes them as text; the
+// offline tool (tools/probe_report.cpp) pairs probes into spans and prints
+// per-span latency percentiles.
+
+#if defined(LLTI_PROBES)
+#define LLTI_PROBE(name) ::llti::probe::record(#name)
+#define LLTI_PROBE_SCOPE(name) \
+    ::llti::probe::Scope llti_probe_scope_(#name "Begin", #name "End")
+#else
+#define LLTI_PROBE(name) ((void)0)
+#define LLTI_PROBE_SCOPE(name) ((void)0)
+#endif
+
+namespace probe {
+
+struct Sample {
+    uint64_t tsc;
+    uint64_t pmc;
+    const char* name;  // string literal, compared by pointer on the hot path
+    uint64_t pad_;
+};
+static_assert(sizeof(Sample) == 32, "two samples per cache line");
+
+class Ring {
+public:
+    Ring(uint32_t thread, size_t capacity)
+        : thread_(thread), mask_(capacity - 1), samples_(capacity) {}
+
+    void push(const char* name, uint64_t tsc, uint64_t pmc) {
+        samples_[head_++ & mask_] = {tsc, pmc, name, 0};
+    }
+
+    uint32_t thread() const { return thread_; }
+    size_t size() const { return std::min<size_t>(head_, samples_.size()); }
+
+    // Oldest-first copy of the retained samples.
+    std::vector<Sample> snapshot() const {
+        std::vector<Sample> out;
+        size_t n = size();
+        out.reserve(n);
+        for (uint64_t i = head_ - n; i < head_; ++i) out.push_back(samples_[i & mask_]);
+        return out;
+    }
+
+    void clear() { head_ = 0; }
+
+private:
+    uint32_t thread_;
+    size_t mask_;
+    uint64_t head_ = 0;
+    std::vector<Sample> samples_;
+};
+
+// Owns every thread's ring so samples survive thread exit.
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry r;
+        return r;
+    }
+
+    Ring* create(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mu_);
+        rings_.push_back(std::make_unique<Ring>(static_cast<uint32_t>(rings_.size()), capacity));
+        return rings_.back().get();
+    }
+
+    template <class F>
+    void for_each(F&& f) const {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (const auto& r : rings_) f(*r);
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (auto& r : rings_) r->clear();
+    }
+
+private:
+    mutable std::mutex mu_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+constexpr size_t kDefaultCapacity = size_t{1} << 20;  // 32 MB per thread
+
+// Calling-thread ring. Call init_thread() before the hot loop to keep the
+// one-time allocation off it; otherwise the first probe allocates.
+inline Ring*& thread_ring_slot() {
+    thread_local Ring* ring = nullptr;
+    return ring;
+}
+
+inline Ring& init_thread(size_t capacity = kDefaultCapacity) {
+    Ring*& ring = thread_ring_slot();
+    if (!ring) {
+        // Round up to a power of two for masking.
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        ring = Registry::instance().create(cap);
+    }
+    return *ring;
+}
+
+inline uint64_t read_pmc() {
+#if defined(LLTI_PROBES_PMC) && (defined(__x86_64__) || defined(__i386__))
+    return __rdpmc(LLTI_PROBES_PMC);
+#else
+    return 0;
+#endif
+}
+
+inline void record(const char* name) {
+    Ring* ring = thread_ring_slot();
+    if (__builtin_expect(ring == nullptr, 0)) ring = &init_thread();
+    ring->push(name, rdtsc(), read_pmc());
+}
+
+class Scope {
+public:
+    Scope(const char* begin, const char* end) : end_(end) { record(begin); }
+    ~Scope() { record(end_); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* end_;
+};
+
+// Text dump: a header line, then "<thread> <tsc> <pmc> <name>" per sample,
+// each thread oldest-first.
+inline void dump(std::FILE* out, double tsc_hz) {
+    std::fprintf(out, "# llti-probes v1 tsc_hz=%.0f\n", tsc_hz);
+    Registry::instance().for_each([&](const Ring& ring) {
+        for (const Sample& s : ring.snapshot())
+            std::fprintf(out, "%u %llu %llu %s\n", ring.thread(),
+                         static_cast<unsigned long long>(s.tsc),
+                         static_cast<unsigned long long>(s.pmc), s.name);
+    });
+}
+
+inline bool dump(const std::string& path, double tsc_hz) {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    dump(f, tsc_hz);
+    return std::fclose(f) == 0;
+}
+
+// --- Offline reconstruction (used by tools/probe_report.cpp) ---
+
+struct Record {
+    uint32_t thread;
+    uint64_t tsc;
+    uint64_t pmc;
+    std::string name;
+};
+
+struct Dump {
+    double tsc_hz = 0.0;
+    std::vector<Record> records;
+};
+
+inline Dump read_dump(std::istream& in) {
+    Dump d;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        if (line[0] == '#') {
+            auto pos = line.find("tsc_hz=");
+            if (pos != std::string::npos) d.tsc_hz = std::stod(line.substr(pos + 7));
+            continue;
+        }
+        std::istringstream ss(line);
+        Record r;
+        if (ss >> r.thread >> r.tsc >> r.pmc >> r.name) d.records.push_back(std::move(r));
+    }
+    return d;
+}
+
+struct Span {
+    std::string name;
+    std::vector<uint64_t> ticks;  // end.tsc - begin.tsc per transaction
+    std::vector<uint64_t> pmc;    // end.pmc - begin.pmc per transaction
+};
+
+// Pair probes into spans, per thread, in record order: each `begin` opens a
+// transaction that the next `end` on the same thread closes. A second
+// `begin` before the `end` restarts the transaction (the first one was cut
+// off, e.g. by an exception or ring wrap-around).
+//
+// With no explicit pairs, every "<X>Begin"/"<X>End" probe pair found in
+// the dump becomes span "<X>". Spans are returned sorted by name.
+inline std::vector<Span> reconstruct_spans(
+    const Dump& dump, std::vector<std::pair<std::string, std::string>> pairs = {}) {
+    if (pairs.empty()) {
+        std::vector<std::string> names;
+        for (const auto& r : dump.records) names.push_back(r.name);
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (const auto& n : names) {
+            if (n.size() > 5 && n.compare(n.size() - 5, 5, "Begin") == 0) {
+                std::string stem = n.substr(0, n.size() - 5);
+                if (std::binary_search(names.begin(), names.end(), stem + "End"))
+                    pairs.emplace_back(n, stem + "End");
+            }
+        }
+    }
+
+    std::vector<Span> spans;
+    for (const auto& [begin, end] : pairs) {
+        Span span;
+        bool stem_pair = begin.size() > 5 && end.size() > 3 &&
+                         begin.compare(begin.size() - 5, 5, "Begin") == 0 &&
+                         end == begin.substr(0, begin.size() - 5) + "End";
+        span.name = stem_pair ? begin.substr(0, begin.size() - 5) : begin + "->" + end;
+
+        std::map<uint32_t, const Record*> open;  // thread -> pending begin
+        for (const auto& r : dump.records) {
+            if (r.name == begin) {
+                open[r.thread] = &r;
+            } else if (r.name == end) {
+                auto it = open.find(r.thread);
+                if (it == open.end() || it->second == nullptr) continue;
+                span.ticks.push_back(r.tsc - it->second->tsc);
+                span.pmc.push_back(r.pmc - it->second->pmc);
+                it->second = nullptr;
+            }
+        }
+        spans.push_back(std::move(span));
+    }
+    std::sort(spans.begin(), spans.end(),
+              [](const Span& a, const Span& b) { return a.name < b.name; });
+    return spans;
+}
+
+} // namespace probe
+} // namespace llti
@@ -0,0 +1,279 @@
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llti/eytzinger_lookup.h"
+#include "llti/probe.h"
+
+namespace llti {
+
+// Eytzinger tables shared between processes through POSIX shared memory.
+//
+// A SharedTablePublisher builds a table once and copies its key and value
+// arrays into a fresh named segment, "/<name>.<generation>". A segment
+// holds only a header plus the arrays, located by byte offsets from the
+// segment start, so it means the same thing wherever a process maps it.
+// Each SharedTableReader maps the current segment read-only. Every process
+// then shares one copy of the pages instead of building its own.
+//
+// A small control segment, "/<name>", holds the generation counter. To
+// republish, the publisher writes a complete new segment and then stores
+// the new generation with release ordering. A reader's refresh() sees the
+// bump, maps the new segment and drops the old one, so lookups never see
+// a half-written table. The publisher unlinks the segment two generations
+// back. A reader still holding it keeps a valid mapping until it
+// refreshes, since unlinking only removes the name.
+//
+// Segments are madvise(MADV_HUGEPAGE)d before they are filled. That
+// places them on huge pages only when shmem THP allows it
+// (/sys/kernel/mm/transparent_hugepage/shmem_enabled set to "advise" or
+// "always"); otherwise they use 4 KB pages and the hint is a no-op.
+//
+// Value must be trivially copyable: it is copied into shared memory and
+// read by other processes as raw bytes.
+
+namespace shared_table_detail {
+
+constexpr uint64_t kMagic = 0x4c4c54495348544dULL;  // "LLTISHTM"
+
+struct Control {
+    std::atomic<uint64_t> generation;  // 0 = nothing published yet
+};
+
+struct Header {
+    uint64_t magic;
+    uint64_t generation;
+    uint64_t n;
+    uint64_t value_size;
+    uint64_t keys_offset;  // 1-indexed Eytzinger keys, n + 1 entries
+    uint64_t vals_offset;  // values at the same positions
+    uint64_t bytes;        // whole segment
+};
+
+inline std::string segment_name(const std::string& name, uint64_t generation) {
+    return "/" + name + "." + std::to_string(generation);
+}
+
+[[noreturn]] inline void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Maps the named segment; `size` 0 means "use its current size" and
+// reports it back.
+inline void* map_segment(const std::string& path, int flags, size_t& size) {
+    int fd = shm_open(path.c_str(), flags, 0644);
+    if (fd < 0) throw_errno("shm_open " + path);
+    bool writable = (flags & O_ACCMODE) == O_RDWR;
+    if (writable && size != 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        throw_errno("ftruncate " + path);
+    }
+    if (size == 0) {
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            close(fd);
+            errno = err;
+            throw_errno("fstat " + path);
+        }
+        size = static_cast<size_t>(st.st_size);
+    }
+    int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* p = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) throw_errno("mmap " + path);
+    return p;
+}
+
+}  // namespace shared_table_detail
+
+template <typename Value>
+class SharedTablePublisher {
+    static_assert(std::is_trivially_copyable_v<Value>, "shared values are copied as raw bytes");
+
+public:
+    // Opens or creates the control segment; publishing continues from its
+    // current generation.
+    explicit SharedTablePublisher(std::string name, bool huge_pages = true)
+        : name_(std::move(name)), huge_pages_(huge_pages) {
+        size_t size = sizeof(shared_table_detail::Control);
+        control_ = static_cast<shared_table_detail::Control*>(
+            shared_table_detail::map_segment("/" + name_, O_CREAT | O_RDWR, size));
+    }
+
+    ~SharedTablePublisher() { munmap(control_, sizeof(shared_table_detail::Control)); }
+    SharedTablePublisher(const SharedTablePublisher&) = delete;
+    SharedTablePublisher& operator=(const SharedTablePublisher&) = delete;
+
+    // Builds `entries` into a new segment and makes it current. Returns
+    // the new generation.
+    uint64_t publish(std::vector<std::pair<int64_t, Value>> entries) {
+        using shared_table_detail::Header;
+        EytzingerLookup<Value> table;
+        table.build(std::move(entries));
+        const uint64_t generation = control_->generation.load(std::memory_order_relaxed) + 1;
+
+        Header header{};
+        header.magic = shared_table_detail::kMagic;
+        header.generation = generation;
+        header.n = table.n;
+        header.value_size = sizeof(Value);
+        header.keys_offset = align(sizeof(Header));
+        header.vals_offset = align(header.keys_offset + (table.n + 1) * sizeof(int64_t));
+        header.bytes = align(header.vals_offset + (table.n + 1) * sizeof(Value));
+
+        const std::string path = shared_table_detail::segment_name(name_, generation);
+        size_t size = header.bytes;
+        char* base = static_cast<char*>(
+            shared_table_detail::map_segment(path, O_CREAT | O_TRUNC | O_RDWR, size));
+        madvise(base, size, huge_pages_ ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+        std::memcpy(base, &header, sizeof(header));
+        if (table.n > 0) {
+            std::memcpy(base + header.keys_offset, table.keys.data(),
+                        (table.n + 1) * sizeof(int64_t));
+            std::memcpy(base + header.vals_offset, table.vals.data(),
+                        (table.n + 1) * sizeof(Value));
+        }
+        munmap(base, size);
+
+        control_->generation.store(generation, std::memory_order_release);
+        if (generation > 2)
+            shm_unlink(shared_table_detail::segment_name(name_, generation - 2).c_str());
+        return generation;
+    }
+
+    uint64_t generation() const { return control_->generation.load(std::memory_order_acquire); }
+
+    // Unlinks the control segment and the last two generations. Mapped
+    // readers keep working; new readers can no longer attach.
+    static void remove(const std::string& name) {
+        size_t size = 0;
+        uint64_t generation = 0;
+        try {
+            auto* control = static_cast<shared_table_detail::Control*>(
+                shared_table_detail::map_segment("/" + name, O_RDONLY, size));
+            generation = control->generation.load(std::memory_order_acquire);
+            munmap(control, size);
+        } catch (const std::system_error&) {
+            return;  // never published
+        }
+        for (uint64_t g = generation; g > 0 && g + 2 > generation; --g)
+            shm_unlink(shared_table_detail::segment_name(name, g).c_str());
+        shm_unlink(("/" + name).c_str());
+    }
+
+private:
+    static uint64_t align(uint64_t offset) { return (offset + 63) & ~uint64_t{63}; }
+
+    std::string name_;
+    bool huge_pages_;
+    shared_table_detail::Control* control_ = nullptr;
+};
+
+// Read-only view of the table a SharedTablePublisher last published under
+// `name`. find() does not synchronize with republishing; call refresh()
+// between lookups, at points where no pointer from a previous find() is
+// still in use, to move to the newest generation.
+template <typename Value>
+class SharedTableReader {
+    static_assert(std::is_trivially_copyable_v<Value>, "shared values are copied as raw bytes");
+
+public:
+    // Throws std::system_error if no publisher ever opened `name`. Until
+    // its first publish the table is empty.
+    explicit SharedTableReader(std::string name) : name_(std::move(name)) {
+        size_t size = 0;
+        control_ = static_cast<const shared_table_detail::Control*>(
+            shared_table_detail::map_segment("/" + name_, O_RDONLY, size));
+        control_size_ = size;
+        refresh();
+    }
+
+    ~SharedTableReader() {
+        unmap();
+        munmap(const_cast<shared_table_detail::Control*>(control_), control_size_);
+    }
+    SharedTableReader(const SharedTableReader&) = delete;
+    SharedTableReader& operator=(const SharedTableReader&) = delete;
+
+    // Switches to the newest published generation; true if it changed.
+    bool refresh() {
+        for (;;) {
+            uint64_t generation = control_->generation.load(std::memory_order_acquire);
+            if (generation == generation_) return false;
+            size_t size = 0;
+            void* base;
+            try {
+                base = shared_table_detail::map_segment(
+                    shared_table_detail::segment_name(name_, generation), O_RDONLY, size);
+            } catch (const std::system_error& e) {
+                // Unlinked by two newer publishes since we read the counter?
+                bool moved_on = control_->generation.load(std::memory_order_acquire) != generation;
+                if (e.code() == std::errc::no_such_file_or_directory && moved_on) continue;
+                throw;
+            }
+            const auto* header = static_cast<const shared_table_detail::Header*>(base);
+            if (size < sizeof(*header) || header->magic != shared_table_detail::kMagic ||
+                header->value_size != sizeof(Value) || header->bytes > size) {
+                munmap(base, size);
+                throw std::runtime_error("SharedTableReader: " + name_ +
+                                         " is not a table of this type");
+            }
+            unmap();
+            base_ = base;
+            size_ = size;
+            generation_ = generation;
+            n_ = header->n;
+            const char* bytes = static_cast<const char*>(base);
+            keys_ = reinterpret_cast<const int64_t*>(bytes + header->keys_offset);
+            vals_ = reinterpret_cast<const Value*>(bytes + header->vals_offset);
+            return true;
+        }
+    }
+
+    const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(SharedTableFind);
+        if (n_ == 0) return nullptr;
+        size_t i = eytzinger_search(keys_, n_, target);
+        return i != 0 ? &vals_[i] : nullptr;
+    }
+
+    uint64_t generation() const { return generation_; }
+    size_t size() const { return n_; }
+    size_t segment_bytes() const { return size_; }
+    const void* segment() const { return base_; }
+
+private:
+    void unmap() {
+        if (base_ != nullptr) munmap(base_, size_);
+        base_ = nullptr;
+    }
+
+    std::string name_;
+    const shared_table_detail::Control* control_ = nullptr;
+    size_t control_size_ = 0;
+    void* base_ = nullptr;
+    size_t size_ = 0;
+    uint64_t generation_ = 0;
+    size_t n_ = 0;
+    const int64_t* keys_ = nullptr;
+    const Value* vals_ = nullptr;
+};
+
+} // namespace llti
@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "llti/probe.h"
+
+namespace llti {
+
+// Build-once bucketized cuckoo hash for exact-match lookups.
+//
+// Each key hashes to two candidate buckets; a bucket is one 64-byte cache
+// line of 8 keys, compared against the target with two AVX2 64-bit
+// compares. Both bucket addresses come straight from the hash, so a lookup
+// issues at most two independent cache-line loads — no dependent chain like
+// the ordered layouts' log2(n) probes — and a miss costs the same as a hit.
+//
+// Empty slots hold `empty_key`, a value chosen at build time that is not a
+// key, so no separate occupancy metadata is needed. With 8-way buckets and
+// two choices, random-walk cuckoo insertion succeeds at the 90% load used
+// here; the bucket count is not a power of two (fastrange maps hashes into
+// it), so memory overhead stays ~1.1x keys + values.
+//
+// Values live in a parallel array indexed like the key slots and are only
+// touched on a hit. Duplicate keys keep the last value.
+
+template <typename Value>
+struct StaticHashLookup {
+    static constexpr size_t kSlots = 8;
+
+    struct alignas(64) Bucket {
+        int64_t keys[kSlots];
+    };
+    static_assert(sizeof(Bucket) == 64, "one bucket per cache line");
+
+    std::pmr::vector<Bucket> buckets;
+    std::pmr::vector<Value> vals;  // vals[bucket * kSlots + slot]
+    size_t n = 0;
+    int64_t empty_key = std::numeric_limits<int64_t>::min();
+    uint64_t seed = 0;
+
+    StaticHashLookup() = default;
+    // Place buckets and vals in `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit StaticHashLookup(std::pmr::memory_resource* mr) : buckets(mr), vals(mr) {}
+
+    void build(std::vector<std::pair<int64_t, Value>> entries) {
+        buckets.clear();
+        vals.clear();
+        n = 0;
+        if (entries.empty()) return;
+        if (entries.size() > (uint64_t{1} << 32) * kSlots * 9 / 10)
+            throw std::overflow_error("StaticHashLookup: too many keys for 32-bit bucket indices");
+
+        empty_key = pick_empty_key(entries);
+        size_t num_buckets = std::max<size_t>(
+            2, static_cast<size_t>(std::ceil(entries.size() / (kSlots * kMaxLoad))));
+        std::mt19937_64 rng(0x5EED);
+        for (int attempt = 0;; ++attempt) {
+            seed = rng();
+            if (try_build(entries, num_buckets, rng)) break;
+            // Another seed usually suffices; grow if the load is the problem.
+            if (attempt % 4 == 3) num_buckets += num_buckets / 20 + 1;
+        }
+    }
+
+    const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(StaticHashFind);
+        if (n == 0 || target == empty_key) return nullptr;
+        uint64_t h = hash(target);
+        size_t b1 = bucket_a(h), b2 = bucket_b(h);
+        const Bucket& x = buckets[b1];
+        const Bucket& y = buckets[b2];
+#if defined(__AVX2__)
+        const __m256i t = _mm256_set1_epi64x(target);
+        auto mask = [&](const Bucket& b) {
+            __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(b.keys));
+            __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(b.keys + 4));
+            int m_lo = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lo, t)));
+            int m_hi = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hi, t)));
+            return static_cast<unsigned>(m_lo | (m_hi << 4));
+        };
+        // Both loads are issued before either result is needed.
+        unsigned m1 = mask(x), m2 = mask(y);
+        if (m1) return &vals[b1 * kSlots + __builtin_ctz(m1)];
+        if (m2) return &vals[b2 * kSlots + __builtin_ctz(m2)];
+#else
+        for (size_t s = 0; s < kSlots; ++s)
+            if (x.keys[s] == target) return &vals[b1 * kSlots + s];
+        for (size_t s = 0; s < kSlots; ++s)
+            if (y.keys[s] == target) return &vals[b2 * kSlots + s];
+#endif
+        return nullptr;
+    }
+
+    // Table bytes per stored key (buckets + value slots).
+    double bytes_per_key() const {
+        if (n == 0) return 0.0;
+        return static_cast<double>(buckets.size() * (sizeof(Bucket) + kSlots * sizeof(Value))) / n;
+    }
+
+private:
+    static constexpr double kMaxLoad = 0.90;
+    static constexpr int kMaxKicks = 500;
+
+    // splitmix64 finalizer, seeded per build.
+    uint64_t hash(int64_t key) const {
+        uint64_t x = static_cast<uint64_t>(key) ^ seed;
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // fastrange: (h32 * buckets) >> 32 maps a 32-bit hash onto [0, buckets).
+    size_t bucket_a(uint64_t h) const {
+        return static_cast<size_t>(((h & 0xffffffffULL) * buckets.size()) >> 32);
+    }
+    size_t bucket_b(uint64_t h) const {
+        size_t b = static_cast<size_t>(((h >> 32) * buckets.size()) >> 32);
+        return b == bucket_a(h) ? (b + 1 == buckets.size() ? 0 : b + 1) : b;
+    }
+
+    static int64_t pick_empty_key(const std::vector<std::pair<int64_t, Value>>& entries) {
+        int64_t candidate = std::numeric_limits<int64_t>::min();
+        for (;;) {
+            bool used = std::any_of(entries.begin(), entries.end(),
+                                    [&](const auto& e) { return e.first == candidate; });
+            if (!used) return candidate;
+            ++candidate;
+        }
+    }
+
+    bool try_build(const std::vector<std::pair<int64_t, Value>>& entries, size_t num_buckets,
+                   std::mt19937_64& rng) {
+        buckets.assign(num_buckets, Bucket{});
+        for (auto& b : buckets) std::fill(std::begin(b.keys), std::end(b.keys), empty_key);
+        vals.assign(num_buckets * kSlots, Value{});
+        n = 0;
+        for (const auto& [key, val] : entries)
+            if (!insert(key, val, rng)) return false;
+        return true;
+    }
+
+    // Overwrite if present, else place into a free slot of either bucket,
+    // else random-walk: evict a random resident into its other bucket.
+    bool insert(int64_t key, Value val, std::mt19937_64& rng) {
+        uint64_t h = hash(key);
+        for (size_t b : {bucket_a(h), bucket_b(h)}) {
+            for (size_t s = 0; s < kSlots; ++s) {
+                if (buckets[b].keys[s] == key) {
+                    vals[b * kSlots + s] = std::move(val);
+                    return true;
+                }
+            }
+        }
+        size_t b = (rng() & 1) ? bucket_a(h) : bucket_b(h);
+        for (int kick = 0; kick < kMaxKicks; ++kick) {
+            uint64_t kh = hash(key);
+            for (size_t cand : {bucket_a(kh), bucket_b(kh)}) {
+                for (size_t s = 0; s < kSlots; ++s) {
+                    if (buckets[cand].keys[s] == empty_key) {
+                        buckets[cand].keys[s] = key;
+                        vals[cand * kSlots + s] = std::move(val);
+                        ++n;
+                        return true;
+                    }
+                }
+            }
+            size_t s = rng() % kSlots;
+            std::swap(key, buckets[b].keys[s]);
+            std::swap(val, vals[b * kSlots + s]);
+            uint64_t eh = hash(key);
+            b = (bucket_a(eh) == b) ? bucket_b(eh) : bucket_a(eh);
+        }
+        return false;
+    }
+};
+
+} // namespace llti
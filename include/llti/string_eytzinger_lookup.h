@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "llti/probe.h"
+
+namespace llti {
+
+// Eytzinger layout for variable-length string keys (ISINs, OCC option
+// symbols, account IDs).
+//
+// Each node stores the key's first 8 bytes as a big-endian uint64, zero
+// padded, so comparing two prefixes as integers orders them like the
+// bytes themselves. The descent is EytzingerLookup's branchless loop over
+// that 8-byte array, with the same 8 nodes per cache line. Only on a
+// prefix tie does it read the node's Tail, a parallel array holding the
+// next 8 bytes the same way, and only if those tie too does it go to
+// `suffixes`, a contiguous arena with every key's bytes past the first 16
+// in sorted order. Keys that differ early never leave the prefix array.
+// Keys sharing a long stem (OCC symbols of one root tie on "ROOT  yy")
+// mostly settle in the Tail, which costs one extra line instead of two.
+//
+// On a tie the two keys agree on their padded bytes so far, so if either
+// is shorter it is a prefix of the other and length decides; otherwise
+// the later bytes decide. Comparing bytes and then lengths covers both.
+
+template <typename Value>
+struct StringEytzingerLookup {
+    struct Tail {
+        uint64_t second;  // bytes 8..15, big-endian and zero padded like the prefix
+        uint32_t offset;  // of the bytes past the first 16 in `suffixes`
+        uint32_t length;  // of the whole key
+    };
+
+    // 1-indexed like EytzingerLookup: index 0 is unused padding
+    std::pmr::vector<uint64_t> prefixes;
+    std::pmr::vector<Tail> tails;
+    std::pmr::vector<char> suffixes;
+    std::pmr::vector<Value> vals;
+    size_t n = 0;
+
+    StringEytzingerLookup() = default;
+    // Place every array in `mr` (e.g. a HugePageArena) instead of the heap.
+    explicit StringEytzingerLookup(std::pmr::memory_resource* mr)
+        : prefixes(mr), tails(mr), suffixes(mr), vals(mr) {}
+
+    void build(std::vector<std::pair<std::string, Value>> entries) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        n = entries.size();
+        suffixes.clear();
+        if (n == 0) return;
+
+        size_t arena = 0;
+        for (const auto& e : entries) arena += e.first.size() > 16 ? e.first.size() - 16 : 0;
+        if (arena > std::numeric_limits<uint32_t>::max())
+            throw std::overflow_error("StringEytzingerLookup: suffix arena exceeds 4 GB");
+
+        prefixes.resize(n + 1);
+        tails.resize(n + 1);
+        vals.resize(n + 1);
+        suffixes.reserve(arena);
+
+        size_t sorted_idx = 0;
+        fill_eytzinger(entries, sorted_idx, 1);
+    }
+
+    const Value* find(std::string_view target) const {
+        LLTI_PROBE_SCOPE(StringEytzingerFind);
+        if (n == 0) return nullptr;
+
+        const uint64_t prefix = load_prefix(target);
+        size_t i = 1;
+        while (i <= n) {
+            __builtin_prefetch(&prefixes[2 * i]);
+            uint64_t p = prefixes[i];
+            bool less = p < prefix;
+            if (__builtin_expect(p == prefix, 0)) less = compare_tail(i, target) < 0;
+            i = 2 * i + less;
+        }
+
+        // Undo the trailing right turns, as in EytzingerLookup::find.
+        i >>= __builtin_ctzll(~i) + 1;
+        if (i > 0 && prefixes[i] == prefix && compare_tail(i, target) == 0) return &vals[i];
+        return nullptr;
+    }
+
+    // The big-endian, zero-padded 8 bytes of `key` from `pos` on.
+    static uint64_t load_prefix(std::string_view key, size_t pos = 0) {
+        uint64_t word = 0;
+        if (key.size() > pos)
+            std::memcpy(&word, key.data() + pos, std::min<size_t>(key.size() - pos, 8));
+        return __builtin_bswap64(word);
+    }
+
+private:
+    // <0, 0, >0 as node i's key orders before, equal to or after `key`,
+    // given equal prefixes.
+    int compare_tail(size_t i, std::string_view key) const {
+        const Tail& t = tails[i];
+        uint64_t second = load_prefix(key, 8);
+        if (t.second != second) return t.second < second ? -1 : 1;
+        std::string_view node_rest(suffixes.data() + t.offset, t.length > 16 ? t.length - 16 : 0);
+        std::string_view key_rest = key.size() > 16 ? key.substr(16) : std::string_view();
+        if (int c = node_rest.compare(key_rest)) return c;
+        return t.length < key.size() ? -1 : (t.length > key.size() ? 1 : 0);
+    }
+
+    void fill_eytzinger(const std::vector<std::pair<std::string, Value>>& sorted,
+                        size_t& sorted_idx, size_t tree_idx) {
+        if (tree_idx > n) return;
+        fill_eytzinger(sorted, sorted_idx, 2 * tree_idx);      // left child
+        const std::string& key = sorted[sorted_idx].first;
+        prefixes[tree_idx] = load_prefix(key);
+        tails[tree_idx] = Tail{load_prefix(key, 8), static_cast<uint32_t>(suffixes.size()),
+                               static_cast<uint32_t>(key.size())};
+        if (key.size() > 16) suffixes.insert(suffixes.end(), key.begin() + 16, key.end());
+        vals[tree_idx] = sorted[sorted_idx].second;
+        ++sorted_idx;
+        fill_eytzinger(sorted, sorted_idx, 2 * tree_idx + 1);  // right child
+    }
+};
+
+} // namespace llti
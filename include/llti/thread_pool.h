@@ -0,0 +1,357 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "llti/topology.h"
+
+namespace llti {
+
+// Idle step for spin-waits: pause for the first 64 attempts, then yield so
+// a waiter cannot starve the thread it waits on when cores are scarce.
+inline void spin_backoff(unsigned attempt) {
+    if (attempt < 64) {
+#if defined(__x86_64__)
+        _mm_pause();
+#endif
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+// Chase–Lev work-stealing deque (Lê et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models", PPoPP 2013).
+//
+// The owner pushes and takes at the bottom (LIFO, so it keeps working on
+// the data it just split); thieves steal from the top (FIFO, so they take
+// the largest, oldest pieces). Only the owner may call push/take; steal is
+// safe from any thread. The ring grows on overflow; retired rings are kept
+// until the deque dies because a thief may still be reading one.
+template <typename T>
+class ChaseLevDeque {
+public:
+    explicit ChaseLevDeque(size_t capacity = 1024) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        rings_.push_back(std::make_unique<Ring>(cap));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    void push(T* item) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Ring* r = ring_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(r->mask)) r = grow(r, t, b);
+        r->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner side; nullptr when empty.
+    T* take() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = r->get(b);
+        if (t == b) {
+            // Last item: race the thieves for it.
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+                item = nullptr;
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Thief side; nullptr when empty or when another thread won the race.
+    T* steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Ring* r = ring_.load(std::memory_order_acquire);
+        T* item = r->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+    // Approximate; exact only when no other thread touches the deque.
+    size_t size() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+private:
+    struct Ring {
+        explicit Ring(size_t cap) : mask(cap - 1), slots(new std::atomic<T*>[cap]) {}
+        T* get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+
+    Ring* grow(Ring* old, int64_t t, int64_t b) {
+        rings_.push_back(std::make_unique<Ring>(2 * (old->mask + 1)));
+        Ring* r = rings_.back().get();
+        for (int64_t i = t; i < b; ++i) r->put(i, old->get(i));
+        ring_.store(r, std::memory_order_release);
+        return r;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Ring*> ring_{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings_;  // owner only
+};
+
+// Fork-join pool over Chase–Lev deques, for batch lookups and builds.
+//
+// The calling thread is participant 0 and works alongside `threads - 1`
+// workers, each pinned to its own physical core under the caller's L3
+// (Topology::place, never the caller's CPU). parallel_for hands the whole
+// range to participant 0, and every participant splits what it holds in
+// halves down to `grain`, keeping the left half and pushing the right
+// half for thieves. An idle participant steals from a random victim, so
+// load balances itself even when chunks cost very different amounts (a
+// vEB miss vs an L1 hit). parallel_for_static is the naive alternative
+// for comparison: one contiguous slice per participant, no stealing.
+//
+// One parallel_for runs at a time (callers on other threads queue on a
+// mutex); a parallel_for issued from inside a task runs inline. Idle
+// workers sleep on a condition variable between calls and spin (pause,
+// then yield) only while a call is in flight.
+class ThreadPool {
+public:
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    // threads == 0 means one participant per online CPU.
+    explicit ThreadPool(size_t threads = 0, bool pin = true) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t i = 0; i < threads; ++i) deques_.push_back(std::make_unique<ChaseLevDeque<Task>>());
+
+        std::vector<int> cpus;
+        if (pin) cpus = worker_cpus(threads - 1);
+        pinned_ = pin && cpus.size() == threads - 1;
+        for (size_t id = 1; id < threads; ++id) {
+            int cpu = id - 1 < cpus.size() ? cpus[id - 1] : -1;
+            workers_.emplace_back([this, id, cpu] {
+                if (cpu >= 0) pin_current_thread(cpu);
+                worker_loop(id);
+            });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return deques_.size(); }
+    // True when every worker got a core of its own.
+    bool pinned() const { return pinned_; }
+
+    // fn(begin, end) over disjoint chunks of at most `grain` indices
+    // covering [0, n). Returns when all have run. fn must not throw: the
+    // job lives on the caller's stack while other threads still run it, so
+    // an exception from fn on any thread calls std::terminate.
+    void parallel_for(size_t n, size_t grain, const RangeFn& fn) { run(n, grain, fn, false); }
+
+    // fn over size() contiguous slices of [0, n), one per participant.
+    void parallel_for_static(size_t n, const RangeFn& fn) { run(n, n, fn, true); }
+
+private:
+    struct Job;
+    struct Task {
+        Job* job;
+        size_t begin, end;
+    };
+    struct Job {
+        const RangeFn* fn;
+        size_t n;
+        size_t grain;
+        bool is_static;
+        uint64_t generation;            // generation_ it was published under
+        std::atomic<size_t> remaining;  // indices not yet processed
+    };
+
+    static thread_local const ThreadPool* tls_pool_;
+
+    static std::vector<int> worker_cpus(size_t count) {
+        auto topo = Topology::discover();
+        std::vector<int> self = current_affinity();
+        int me = self.size() == 1 ? self.front() : -1;
+        std::vector<int> cpus = topo.place(count + 1);
+        cpus.erase(std::remove_if(cpus.begin(), cpus.end(),
+                                  [&](int c) { return c == me || topo.are_siblings(me, c); }),
+                   cpus.end());
+        if (cpus.size() > count) cpus.resize(count);
+        return cpus;
+    }
+
+    void run(size_t n, size_t grain, const RangeFn& fn, bool is_static) {
+        if (n == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        if (tls_pool_ == this || deques_.size() == 1) {
+            fn(0, n);  // nested or single-threaded: inline
+            return;
+        }
+        std::lock_guard<std::mutex> submit(submit_mutex_);
+        Job job;
+        job.fn = &fn;
+        job.n = n;
+        job.grain = grain;
+        job.is_static = is_static;
+        job.generation = generation_ + 1;  // only submitters write generation_
+        job.remaining.store(n, std::memory_order_relaxed);
+        if (!is_static) deques_[0]->push(new Task{&job, 0, n});
+
+        const ThreadPool* outer = tls_pool_;  // a pool whose task this call runs in
+        tls_pool_ = this;
+        // The job stays current until it is done, so every worker sees it:
+        // each wakes for this generation and finds current_ still set.
+        current_.store(&job, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            generation_ = job.generation;
+        }
+        wake_.notify_all();
+
+        if (is_static) run_slice(job, 0);
+        work_until_done(job, 0);
+
+        // A worker that loaded &job is counted in active_ until it lets go.
+        current_.store(nullptr, std::memory_order_seq_cst);
+        while (active_.load(std::memory_order_seq_cst) != 0) spin_backoff(64);
+        // Restore rather than clear, so a later call back into the outer pool
+        // from the same task still runs inline instead of queueing behind
+        // the submitter that is waiting for this task.
+        tls_pool_ = outer;
+    }
+
+    void worker_loop(size_t id) {
+        tls_pool_ = this;
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+            active_.fetch_add(1, std::memory_order_seq_cst);
+            // Join only the job this wake-up was for. A worker that wakes
+            // late may find the next job already current; it takes that one
+            // on its next pass instead, so it never runs a static slice twice.
+            Job* job = current_.load(std::memory_order_seq_cst);
+            if (job != nullptr && job->generation == seen) {
+                if (job->is_static) run_slice(*job, id);
+                work_until_done(*job, id);
+            }
+            active_.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    void run_slice(Job& job, size_t slice) {
+        size_t p = deques_.size();
+        size_t begin = job.n * slice / p, end = job.n * (slice + 1) / p;
+        if (begin < end) call(*job.fn, begin, end);
+        job.remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+    }
+
+    void work_until_done(Job& job, size_t id) {
+        uint64_t rng = 0x9E3779B97F4A7C15ULL * (id + 1);
+        unsigned idle = 0;
+        while (job.remaining.load(std::memory_order_acquire) != 0) {
+            Task* task = deques_[id]->take();
+            if (!task) {
+                rng ^= rng << 13;
+                rng ^= rng >> 7;
+                rng ^= rng << 17;
+                size_t victim = rng % deques_.size();
+                if (victim != id) task = deques_[victim]->steal();
+            }
+            if (!task) {
+                spin_backoff(++idle);
+                continue;
+            }
+            idle = 0;
+            execute(task, id);
+        }
+    }
+
+    // Split down to grain, pushing right halves, then run the left piece.
+    void execute(Task* task, size_t id) {
+        Job& job = *task->job;
+        size_t begin = task->begin, end = task->end;
+        delete task;
+        while (end - begin > job.grain) {
+            size_t mid = begin + (end - begin) / 2;
+            deques_[id]->push(new Task{&job, mid, end});
+            end = mid;
+        }
+        call(*job.fn, begin, end);
+        job.remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+    }
+
+    // Pooled chunks run through here, so a throwing fn terminates at once
+    // instead of unwinding past a job other threads still reference.
+    static void call(const RangeFn& fn, size_t begin, size_t end) noexcept { fn(begin, end); }
+
+    std::vector<std::unique_ptr<ChaseLevDeque<Task>>> deques_;  // [0] is the caller's
+    std::vector<std::thread> workers_;
+    bool pinned_ = false;
+
+    std::mutex submit_mutex_;
+    std::atomic<Job*> current_{nullptr};
+    std::atomic<int> active_{0};  // workers that may be holding current_
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
+inline thread_local const ThreadPool* ThreadPool::tls_pool_ = nullptr;
+
+// out[q] = table.find(queries[q]) for q in [0, count), fanned out over the
+// pool in chunks of `grain` queries. Works with every lookup layout (any
+// table with `const V* find(int64_t) const`).
+template <class Table>
+void parallel_find(ThreadPool& pool, const Table& table, const int64_t* queries, size_t count,
+                   decltype(std::declval<const Table&>().find(int64_t{}))* out, size_t grain = 4096) {
+    pool.parallel_for(count, grain, [&](size_t begin, size_t end) {
+        for (size_t q = begin; q < end; ++q) out[q] = table.find(queries[q]);
+    });
+}
+
+} // namespace llti
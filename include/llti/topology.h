@@ -0,0 +1,291 @@
+#pragma once
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llti {
+
+// CPU topology discovery straight from /sys and /proc.
+//
+// hwloc is unusable on RRM-managed hosts: its x86 backend binds to every
+// isolated core and executes CPUID there, which hangs (see
+// Orderbook/htop_hwloc_redlineRRM_story.md). Everything we need for thread
+// placement — SMT siblings, L2/L3 sharing, NUMA nodes, isolcpus/nohz_full —
+// is already exported by the kernel as plain text, so we read only that.
+// Discovery never binds threads and never executes CPUID.
+//
+// Missing files are tolerated: fields fall back to -1 / empty, so the
+// module degrades gracefully inside containers and VMs with a thin sysfs.
+
+// Parse a kernel cpulist ("0-3,8,10-11") into sorted, unique CPU ids.
+// Non-numeric tokens (isolcpus flags such as "domain" or "managed_irq")
+// are skipped so /proc/cmdline values can be passed through unchanged.
+inline std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        token.erase(std::remove_if(token.begin(), token.end(),
+                                   [](unsigned char c) { return std::isspace(c); }),
+                    token.end());
+        if (token.empty() || !std::isdigit(static_cast<unsigned char>(token[0]))) continue;
+
+        char* end = nullptr;
+        long lo = std::strtol(token.c_str(), &end, 10);
+        long hi = lo;
+        if (*end == '-') hi = std::strtol(end + 1, &end, 10);
+        if (*end != '\0' || hi < lo) continue;
+        for (long c = lo; c <= hi; ++c) cpus.push_back(static_cast<int>(c));
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+// Contents of a sysfs/procfs file without the trailing newline, or "" if
+// the file is missing or unreadable.
+inline std::string read_sysfs(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return {};
+    std::string s((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.pop_back();
+    return s;
+}
+
+struct CpuInfo {
+    int cpu = -1;
+    int package = -1;
+    int core = -1;       // core_id, unique within a package
+    int numa_node = -1;
+    int l2_domain = -1;  // lowest CPU id sharing this CPU's L2
+    int l3_domain = -1;  // lowest CPU id sharing this CPU's L3
+    std::vector<int> siblings;  // SMT siblings, including this CPU
+    bool isolated = false;
+    bool nohz_full = false;
+};
+
+struct Topology {
+    std::vector<CpuInfo> cpus;  // online CPUs, ascending id
+    std::vector<int> isolated;
+    std::vector<int> nohz_full;
+    size_t l1d_bytes = 0;
+    size_t l2_bytes = 0;
+    size_t l3_bytes = 0;
+
+    // Roots are parameters so tests can point discovery at a fake tree.
+    static Topology discover(const std::string& sys_root = "/sys",
+                             const std::string& proc_root = "/proc") {
+        Topology topo;
+        const std::string cpu_root = sys_root + "/devices/system/cpu";
+
+        std::vector<int> online = parse_cpu_list(read_sysfs(cpu_root + "/online"));
+        if (online.empty()) {
+            // Older kernels and some containers lack "online"; enumerate cpuN dirs.
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(cpu_root, ec)) {
+                const std::string name = entry.path().filename().string();
+                if (name.size() > 3 && name.compare(0, 3, "cpu") == 0 &&
+                    std::all_of(name.begin() + 3, name.end(),
+                                [](unsigned char c) { return std::isdigit(c); }))
+                    online.push_back(std::stoi(name.substr(3)));
+            }
+            std::sort(online.begin(), online.end());
+        }
+
+        // isolcpus/nohz_full: prefer the sysfs view, fall back to the boot cmdline.
+        const std::string cmdline = read_sysfs(proc_root + "/cmdline");
+        topo.isolated = parse_cpu_list(read_sysfs(cpu_root + "/isolated"));
+        if (topo.isolated.empty()) topo.isolated = parse_cpu_list(cmdline_value(cmdline, "isolcpus"));
+        topo.nohz_full = parse_cpu_list(read_sysfs(cpu_root + "/nohz_full"));
+        if (topo.nohz_full.empty()) topo.nohz_full = parse_cpu_list(cmdline_value(cmdline, "nohz_full"));
+
+        std::map<int, int> cpu_to_node;
+        std::error_code ec;
+        for (const auto& entry :
+             std::filesystem::directory_iterator(sys_root + "/devices/system/node", ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                !std::isdigit(static_cast<unsigned char>(name[4])))
+                continue;
+            int node = std::stoi(name.substr(4));
+            for (int c : parse_cpu_list(read_sysfs(entry.path().string() + "/cpulist")))
+                cpu_to_node[c] = node;
+        }
+
+        for (int c : online) {
+            const std::string dir = cpu_root + "/cpu" + std::to_string(c);
+            CpuInfo info;
+            info.cpu = c;
+            info.package = read_int(dir + "/topology/physical_package_id");
+            info.core = read_int(dir + "/topology/core_id");
+            info.siblings = parse_cpu_list(read_sysfs(dir + "/topology/thread_siblings_list"));
+            if (info.siblings.empty()) info.siblings = {c};
+            auto node = cpu_to_node.find(c);
+            info.numa_node = node != cpu_to_node.end() ? node->second : -1;
+            info.isolated = std::binary_search(topo.isolated.begin(), topo.isolated.end(), c);
+            info.nohz_full = std::binary_search(topo.nohz_full.begin(), topo.nohz_full.end(), c);
+
+            for (int idx = 0;; ++idx) {
+                const std::string cache = dir + "/cache/index" + std::to_string(idx);
+                const std::string level = read_sysfs(cache + "/level");
+                if (level.empty()) break;
+                const std::string type = read_sysfs(cache + "/type");
+                if (type == "Instruction") continue;
+                std::vector<int> shared = parse_cpu_list(read_sysfs(cache + "/shared_cpu_list"));
+                int domain = shared.empty() ? c : shared.front();
+                size_t size = parse_size(read_sysfs(cache + "/size"));
+                if (level == "1") {
+                    topo.l1d_bytes = std::max(topo.l1d_bytes, size);
+                } else if (level == "2") {
+                    info.l2_domain = domain;
+                    topo.l2_bytes = std::max(topo.l2_bytes, size);
+                } else if (level == "3") {
+                    info.l3_domain = domain;
+                    topo.l3_bytes = std::max(topo.l3_bytes, size);
+                }
+            }
+            topo.cpus.push_back(std::move(info));
+        }
+        return topo;
+    }
+
+    const CpuInfo* cpu(int id) const {
+        auto it = std::lower_bound(cpus.begin(), cpus.end(), id,
+                                   [](const CpuInfo& info, int v) { return info.cpu < v; });
+        return (it != cpus.end() && it->cpu == id) ? &*it : nullptr;
+    }
+
+    bool are_siblings(int a, int b) const {
+        const CpuInfo* ia = cpu(a);
+        return ia && std::binary_search(ia->siblings.begin(), ia->siblings.end(), b);
+    }
+
+    bool shares_l3(int a, int b) const {
+        const CpuInfo* ia = cpu(a);
+        const CpuInfo* ib = cpu(b);
+        return ia && ib && ia->l3_domain >= 0 && ia->l3_domain == ib->l3_domain;
+    }
+
+    // Pick `count` CPUs for latency-critical threads: at most one CPU per
+    // physical core (no SMT sibling shares a pipeline with another pick),
+    // all under the same L3, isolated CPUs first, CPU 0 last (it carries
+    // housekeeping IRQs on every distro we run). The L3 domain with the
+    // most isolated cores wins. May return fewer than `count` CPUs when
+    // the host is too small — callers decide whether that is fatal.
+    std::vector<int> place(size_t count) const {
+        // Group one representative CPU per physical core by L3 domain.
+        std::map<int, std::vector<const CpuInfo*>> by_l3;
+        for (const CpuInfo& info : cpus) {
+            if (std::any_of(info.siblings.begin(), info.siblings.end(),
+                            [&](int s) { return s < info.cpu && cpu(s) != nullptr; }))
+                continue;  // a lower-numbered online sibling represents this core
+            by_l3[info.l3_domain].push_back(&info);
+        }
+
+        auto rank = [](const CpuInfo* info) {
+            return std::make_pair(info->isolated ? 0 : (info->cpu == 0 ? 2 : 1), info->cpu);
+        };
+
+        std::vector<int> best;
+        size_t best_isolated = 0;
+        for (auto& [domain, cores] : by_l3) {
+            std::sort(cores.begin(), cores.end(),
+                      [&](const CpuInfo* a, const CpuInfo* b) { return rank(a) < rank(b); });
+            std::vector<int> pick;
+            size_t n_isolated = 0;
+            for (const CpuInfo* info : cores) {
+                if (pick.size() == count) break;
+                pick.push_back(info->cpu);
+                n_isolated += info->isolated;
+            }
+            if (best.empty() || n_isolated > best_isolated ||
+                (n_isolated == best_isolated && pick.size() > best.size())) {
+                best = std::move(pick);
+                best_isolated = n_isolated;
+            }
+        }
+        return best;
+    }
+
+    // The canonical trading pipeline: feed handler, book builder, strategy.
+    struct PipelinePlacement {
+        int feed = -1;
+        int book = -1;
+        int strategy = -1;
+    };
+
+    PipelinePlacement place_pipeline() const {
+        std::vector<int> picked = place(3);
+        PipelinePlacement p;
+        if (picked.size() > 0) p.feed = picked[0];
+        if (picked.size() > 1) p.book = picked[1];
+        if (picked.size() > 2) p.strategy = picked[2];
+        return p;
+    }
+
+private:
+    static int read_int(const std::string& path) {
+        std::string s = read_sysfs(path);
+        return s.empty() ? -1 : std::atoi(s.c_str());
+    }
+
+    // sysfs cache sizes look like "48K", "2048K" or "300M".
+    static size_t parse_size(const std::string& s) {
+        if (s.empty()) return 0;
+        char* end = nullptr;
+        size_t v = std::strtoull(s.c_str(), &end, 10);
+        switch (*end) {
+            case 'K': return v << 10;
+            case 'M': return v << 20;
+            case 'G': return v << 30;
+            default:  return v;
+        }
+    }
+
+    // Value of "key=value" in a kernel command line, or "" if absent.
+    static std::string cmdline_value(const std::string& cmdline, const std::string& key) {
+        std::stringstream ss(cmdline);
+        std::string word;
+        while (ss >> word) {
+            if (word.size() > key.size() && word.compare(0, key.size(), key) == 0 &&
+                word[key.size()] == '=')
+                return word.substr(key.size() + 1);
+        }
+        return {};
+    }
+};
+
+// Bind the calling thread to a single CPU. Returns false if the kernel
+// refuses (CPU offline, outside our cpuset) — the thread keeps its old mask.
+inline bool pin_current_thread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// CPUs the calling thread is currently allowed to run on.
+inline std::vector<int> current_affinity() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) return cpus;
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+        if (CPU_ISSET(c, &set)) cpus.push_back(c);
+    return cpus;
+}
+
+} // namespace llti
@@ -0,0 +1,53 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace llti {
+
+// Time-stamp counter helpers.
+//
+// On the hosts we care about (constant_tsc + nonstop_tsc) the TSC ticks at a
+// fixed rate regardless of P-states, so cycle deltas convert to wall time
+// with one multiply. rdtsc is not serializing: it can execute before older
+// loads retire. That is fine for spans of tens of nanoseconds and up; for
+// single-instruction timing use rdtscp or lfence brackets.
+
+inline uint64_t rdtsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Waits for all prior instructions to complete before reading the counter.
+inline uint64_t rdtscp() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned aux;
+    return __rdtscp(&aux);
+#else
+    return rdtsc();
+#endif
+}
+
+// Measure TSC ticks per second against steady_clock over `window`.
+// 20 ms gives ~5 significant digits; the caller should be pinned.
+inline double measure_tsc_hz(std::chrono::milliseconds window = std::chrono::milliseconds(20)) {
+    using clock = std::chrono::steady_clock;
+    auto t0 = clock::now();
+    uint64_t c0 = rdtscp();
+    auto deadline = t0 + window;
+    clock::time_point t1;
+    do {
+        t1 = clock::now();
+    } while (t1 < deadline);
+    uint64_t c1 = rdtscp();
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(c1 - c0) / secs;
+}
+
+} // namespace llti
@@ -3,9 +3,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory_resource>
 #include <stdexcept>
 #include <vector>
 
+#include "llti/delta_merge.h"
+#include "llti/probe.h"
+
 namespace llti {
 
 // van Emde Boas (vEB) layout for cache-oblivious binary search.
@@ -23,14 +27,44 @@ struct VebLookup {
         uint32_t children[2]; // [0]=left, [1]=right
     };
 
-    std::vector<SearchData> tree;
-    std::vector<Value> vals;
+    std::pmr::vector<SearchData> tree;
+    std::pmr::vector<Value> vals;
     size_t n = 0;
     uint32_t root_idx = 0;
 
+    VebLookup() = default;
+    // Place tree and vals in `mr` (e.g. a HugePageArena) instead of the heap.
+    // The build's index temporaries stay on the default heap.
+    explicit VebLookup(std::pmr::memory_resource* mr) : tree(mr), vals(mr) {}
+
     void build(std::vector<std::pair<int64_t, Value>> entries) {
         std::sort(entries.begin(), entries.end(),
                   [](const auto& a, const auto& b) { return a.first < b.first; });
+        build_sorted(std::move(entries));
+    }
+
+    // Apply a small delta without re-sorting (see DeltaMerge). The current
+    // entries are read in key order by an in-order walk over the child
+    // links, then the layout is rebuilt from the merged sequence.
+    void rebuild_with(std::vector<std::pair<int64_t, Value>> upserts, std::vector<int64_t> deletes) {
+        DeltaMerge<Value> merge(std::move(upserts), std::move(deletes), n);
+        std::vector<uint32_t> stack;
+        uint32_t curr = n > 0 ? root_idx : 0;
+        while (curr != 0 || !stack.empty()) {
+            while (curr != 0) {
+                stack.push_back(curr);
+                curr = tree[curr].children[0];
+            }
+            curr = stack.back();
+            stack.pop_back();
+            merge(tree[curr].key, vals[curr]);
+            curr = tree[curr].children[1];
+        }
+        build_sorted(merge.finish());
+    }
+
+    // build() for entries already sorted by key.
+    void build_sorted(std::vector<std::pair<int64_t, Value>> entries) {
         n = entries.size();
         if (n == 0) return;
 
@@ -84,6 +118,7 @@ struct VebLookup {
     }
 
     const Value* find(int64_t target) const {
+        LLTI_PROBE_SCOPE(VebFind);
         if (n == 0) return nullptr;
 
         uint32_t curr = root_idx;
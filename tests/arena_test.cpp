@@ -0,0 +1,94 @@
+#include "llti/arena.h"
+#include "llti/eytzinger_lookup.h"
+#include "llti/order_book.h"
+#include "llti/sorted_lookup.h"
+#include "llti/veb_lookup.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<std::pair<int64_t, int64_t>> random_entries(size_t n) {
+    std::mt19937_64 rng(5);
+    std::vector<std::pair<int64_t, int64_t>> entries(n);
+    for (auto& [k, v] : entries) {
+        k = static_cast<int64_t>(rng());
+        v = k ^ 1;
+    }
+    return entries;
+}
+
+bool in_arena(const llti::HugePageArena& arena, const void* p) {
+    auto* b = static_cast<const char*>(arena.base());
+    auto* q = static_cast<const char*>(p);
+    return q >= b && q < b + arena.capacity();
+}
+
+}  // namespace
+
+TEST(HugePageArenaTest, BumpAllocatesAligned) {
+    llti::HugePageArena arena(1 << 20);
+    EXPECT_EQ(arena.capacity(), llti::HugePageArena::kHugePage);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(arena.base()) % llti::HugePageArena::kHugePage, 0u);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    EXPECT_GT(b, a);
+    EXPECT_EQ(arena.used(), 72u);
+    arena.deallocate(b, 8, 64);  // no-op
+    EXPECT_EQ(arena.used(), 72u);
+}
+
+TEST(HugePageArenaTest, ExhaustionThrowsAndReleaseResets) {
+    llti::HugePageArena arena(llti::HugePageArena::kHugePage);
+    (void)arena.allocate(arena.capacity() - 16, 8);
+    EXPECT_THROW((void)arena.allocate(32, 8), std::bad_alloc);
+    arena.release();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_NO_THROW((void)arena.allocate(arena.capacity(), 8));
+}
+
+TEST(HugePageArenaTest, LookupsBuildInArena) {
+    auto entries = random_entries(50'000);
+    llti::HugePageArena arena(size_t{64} << 20);
+
+    llti::SortedLookup<int64_t> sorted(&arena);
+    llti::EytzingerLookup<int64_t> eytz(&arena);
+    llti::VebLookup<int64_t> veb(&arena);
+    sorted.build(entries);
+    eytz.build(entries);
+    veb.build(entries);
+
+    EXPECT_TRUE(in_arena(arena, sorted.keys.data()));
+    EXPECT_TRUE(in_arena(arena, eytz.keys.data()));
+    EXPECT_TRUE(in_arena(arena, veb.tree.data()));
+    EXPECT_TRUE(in_arena(arena, veb.vals.data()));
+    EXPECT_GE(arena.used(), entries.size() * (16 + 16 + 24));
+
+    for (size_t i = 0; i < entries.size(); i += 97) {
+        auto [k, v] = entries[i];
+        ASSERT_NE(sorted.find(k), nullptr);
+        ASSERT_NE(eytz.find(k), nullptr);
+        ASSERT_NE(veb.find(k), nullptr);
+        EXPECT_EQ(*sorted.find(k), v);
+        EXPECT_EQ(*eytz.find(k), v);
+        EXPECT_EQ(*veb.find(k), v);
+    }
+}
+
+TEST(HugePageArenaTest, OrderBookMapInArena) {
+    llti::HugePageArena arena(size_t{64} << 20);
+    auto book = std::make_unique<llti::OrderBook>(10'000, 15'000, &arena);
+    // 2M slots x 16 bytes for the id map, plus the price levels.
+    EXPECT_GE(arena.used(), llti::MAX_ORDERS * 2 * 16);
+
+    book->add_order(1, 10'500, 100);
+    book->add_order(2, 10'500, 25);
+    book->cancel_order(1);
+    EXPECT_EQ(book->get_volume_at_price(10'500), 25);
+    EXPECT_EQ(book->num_orders(), 1u);
+}
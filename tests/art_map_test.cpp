@@ -0,0 +1,127 @@
+#include "llti/arena.h"
+#include "llti/art_map.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Checks find() for every key of `ref` and the full ordered walk against
+// a std::map.
+template <typename Value>
+void expect_same(const llti::ArtMap<Value>& art, const std::map<int64_t, Value>& ref) {
+    ASSERT_EQ(art.size(), ref.size());
+    for (const auto& [key, value] : ref) {
+        auto* found = art.find(key);
+        ASSERT_NE(found, nullptr) << key;
+        EXPECT_EQ(*found, value);
+    }
+    auto it = ref.begin();
+    art.for_each([&](int64_t key, const Value& value) {
+        ASSERT_NE(it, ref.end());
+        EXPECT_EQ(key, it->first);
+        EXPECT_EQ(value, it->second);
+        ++it;
+    });
+    EXPECT_EQ(it, ref.end());
+}
+
+}  // namespace
+
+TEST(ArtMapTest, EmptyMap) {
+    llti::ArtMap<int64_t> art;
+    EXPECT_TRUE(art.empty());
+    EXPECT_EQ(art.find(0), nullptr);
+    EXPECT_FALSE(art.erase(0));
+    int visited = 0;
+    art.for_each([&](int64_t, const int64_t&) { ++visited; });
+    EXPECT_EQ(visited, 0);
+}
+
+TEST(ArtMapTest, RandomInsertEraseMatchesStdMap) {
+    // Dense, sparse and negative keys so every node type grows and shrinks.
+    std::mt19937_64 rng(3);
+    auto random_key = [&] {
+        switch (rng() % 3) {
+            case 0: return static_cast<int64_t>(rng() % 2000);     // Node256 at the bottom
+            case 1: return -static_cast<int64_t>(rng() % 100000);  // negatives
+            default: return static_cast<int64_t>(rng());            // full range
+        }
+    };
+    llti::ArtMap<int64_t> art;
+    std::map<int64_t, int64_t> ref;
+    for (int op = 0; op < 200000; ++op) {
+        int64_t key = random_key();
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(art.erase(key), ref.erase(key) == 1) << key;
+        } else {
+            int64_t value = static_cast<int64_t>(rng());
+            EXPECT_EQ(art.insert(key, value), ref.count(key) == 0) << key;
+            ref[key] = value;
+        }
+        if (op % 50000 == 0) expect_same(art, ref);
+    }
+    expect_same(art, ref);
+
+    // Erase everything; the tree collapses back to empty.
+    for (const auto& [key, value] : ref) ASSERT_TRUE(art.erase(key)) << key;
+    EXPECT_TRUE(art.empty());
+    EXPECT_EQ(art.find(ref.begin()->first), nullptr);
+}
+
+TEST(ArtMapTest, ScanMatchesStdMapRanges) {
+    std::mt19937_64 rng(9);
+    llti::ArtMap<int64_t> art;
+    std::map<int64_t, int64_t> ref;
+    for (int64_t i = 0; i < 20000; ++i) {
+        int64_t key = i % 2 ? static_cast<int64_t>(rng()) : 1'000'000 + i * 7;  // IDs + random
+        art.insert(key, i);
+        ref[key] = i;
+    }
+    auto check = [&](int64_t lo, int64_t hi) {
+        std::vector<int64_t> got;
+        art.scan(lo, hi, [&](int64_t key, const int64_t& value) {
+            EXPECT_EQ(value, ref[key]);
+            got.push_back(key);
+        });
+        std::vector<int64_t> want;
+        for (auto it = ref.lower_bound(lo); it != ref.end() && it->first <= hi; ++it)
+            want.push_back(it->first);
+        EXPECT_EQ(got, want) << lo << " " << hi;
+    };
+    check(1'000'000, 1'000'700);
+    check(1'000'001, 1'000'006);
+    check(-5, 5);
+    check(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+    check(5, -5);
+    for (int i = 0; i < 200; ++i) {
+        int64_t lo = static_cast<int64_t>(rng());
+        check(lo, lo + static_cast<int64_t>(rng() >> 8));
+    }
+}
+
+TEST(ArtMapTest, NonTrivialValuesAndRecycledNodes) {
+    llti::HugePageArena arena(size_t{64} << 20);
+    llti::ArtMap<std::string> art(&arena);
+    for (int64_t i = 0; i < 10000; ++i) art.insert(i, std::string(40, 'a' + i % 26));
+    EXPECT_EQ(*art.find(27), std::string(40, 'b'));
+    EXPECT_FALSE(art.insert(27, "updated"));
+    EXPECT_EQ(*art.find(27), "updated");
+
+    // Churning the same number of live keys reuses freed nodes and leaves.
+    const size_t used = arena.used();
+    for (int64_t i = 0; i < 100000; ++i) {
+        ASSERT_TRUE(art.erase(i));
+        ASSERT_TRUE(art.insert(i + 10000, std::to_string(i)));
+    }
+    EXPECT_EQ(art.size(), 10000u);
+    EXPECT_LE(arena.used(), used + (size_t{256} << 10));
+    EXPECT_EQ(*art.find(109999), "99999");
+    art.clear();
+    EXPECT_TRUE(art.empty());
+    EXPECT_EQ(art.memory_bytes(), 0u);
+}
@@ -0,0 +1,73 @@
+#include "llti/as_of_lookup.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <map>
+#include <random>
+
+using Version = llti::AsOfLookup<int64_t>::Version;
+
+TEST(AsOfLookupTest, ValueAsOfTime) {
+    llti::AsOfLookup<int64_t> table;
+    table.build({{7, 100, 1}, {7, 200, 2}, {7, 300, 3}, {9, 50, 10}});
+    EXPECT_EQ(table.num_keys(), 2u);
+    EXPECT_EQ(table.num_versions(), 4u);
+
+    EXPECT_EQ(table.find(7, 99), nullptr);
+    EXPECT_EQ(*table.find(7, 100), 1);
+    EXPECT_EQ(*table.find(7, 199), 1);
+    EXPECT_EQ(*table.find(7, 200), 2);
+    EXPECT_EQ(*table.find(7, 299), 2);
+    EXPECT_EQ(*table.find(7, 300), 3);
+    EXPECT_EQ(*table.find(7, std::numeric_limits<int64_t>::max()), 3);
+    EXPECT_EQ(table.find(9, 49), nullptr);
+    EXPECT_EQ(*table.find(9, 50), 10);
+    EXPECT_EQ(table.find(8, 1000), nullptr);
+}
+
+TEST(AsOfLookupTest, EmptyTable) {
+    llti::AsOfLookup<int64_t> table;
+    table.build({});
+    EXPECT_EQ(table.find(0, 0), nullptr);
+    EXPECT_EQ(table.num_keys(), 0u);
+}
+
+TEST(AsOfLookupTest, UnsortedInputAndSameInstantLastWins) {
+    llti::AsOfLookup<int64_t> table;
+    table.build({{5, 30, 3}, {5, 10, 1}, {5, 20, 2}, {5, 20, 22}, {-5, 0, -1}});
+    EXPECT_EQ(table.num_versions(), 4u);
+    EXPECT_EQ(*table.find(5, 25), 22);
+    EXPECT_EQ(*table.find(5, 10), 1);
+    EXPECT_EQ(*table.find(-5, 0), -1);
+}
+
+TEST(AsOfLookupTest, MatchesMapOfVectors) {
+    std::mt19937_64 rng(17);
+    std::vector<Version> versions;
+    std::map<int64_t, std::map<int64_t, int64_t>> reference;
+    for (int k = 0; k < 2000; ++k) {
+        int64_t key = static_cast<int64_t>(rng());
+        int count = 1 + static_cast<int>(rng() % 50);
+        for (int v = 0; v < count; ++v) {
+            int64_t time = static_cast<int64_t>(rng() % 10000);
+            int64_t value = static_cast<int64_t>(rng());
+            versions.push_back({key, time, value});
+            reference[key][time] = value;
+        }
+    }
+    llti::AsOfLookup<int64_t> table;
+    table.build(versions);
+
+    for (int q = 0; q < 20000; ++q) {
+        const Version& v = versions[rng() % versions.size()];
+        int64_t time = v.time + static_cast<int64_t>(rng() % 200) - 100;
+        const auto& history = reference[v.key];
+        auto it = history.upper_bound(time);
+        const int64_t* got = table.find(v.key, time);
+        if (it == history.begin()) {
+            EXPECT_EQ(got, nullptr);
+        } else {
+            ASSERT_NE(got, nullptr);
+            EXPECT_EQ(*got, std::prev(it)->second);
+        }
+    }
+}
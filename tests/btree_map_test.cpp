@@ -0,0 +1,139 @@
+#include "llti/arena.h"
+#include "llti/btree_map.h"
+#include "llti/sorted_lookup.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+void expect_same(const llti::BTreeMap<int64_t>& tree, const std::map<int64_t, int64_t>& ref) {
+    ASSERT_EQ(tree.size(), ref.size());
+    for (const auto& [key, value] : ref) {
+        auto* found = tree.find(key);
+        ASSERT_NE(found, nullptr) << key;
+        EXPECT_EQ(*found, value);
+    }
+    auto it = ref.begin();
+    tree.for_each([&](int64_t key, const int64_t& value) {
+        ASSERT_NE(it, ref.end());
+        EXPECT_EQ(key, it->first);
+        EXPECT_EQ(value, it->second);
+        ++it;
+    });
+    EXPECT_EQ(it, ref.end());
+}
+
+}  // namespace
+
+TEST(BTreeMapTest, EmptyTree) {
+    llti::BTreeMap<int64_t> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.find(0), nullptr);
+    EXPECT_FALSE(tree.erase(0));
+    tree.scan(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(),
+              [](int64_t, const int64_t&) { FAIL(); });
+}
+
+TEST(BTreeMapTest, RandomInsertEraseMatchesStdMap) {
+    // A narrow key range so erases empty whole leaves, plus the extremes.
+    std::mt19937_64 rng(4);
+    llti::BTreeMap<int64_t> tree;
+    std::map<int64_t, int64_t> ref;
+    for (int op = 0; op < 300000; ++op) {
+        int64_t key = static_cast<int64_t>(rng() % 50000) - 25000;
+        if (op % 1000 == 0) key = op % 2000 ? std::numeric_limits<int64_t>::max()
+                                            : std::numeric_limits<int64_t>::min();
+        // Grow for the first half, shrink in the second.
+        bool erase = rng() % 10 < (op < 150000 ? 3u : 7u);
+        if (erase) {
+            EXPECT_EQ(tree.erase(key), ref.erase(key) == 1) << key;
+        } else {
+            int64_t value = static_cast<int64_t>(rng());
+            EXPECT_EQ(tree.insert(key, value), ref.count(key) == 0) << key;
+            ref[key] = value;
+        }
+        if (op % 50000 == 0) expect_same(tree, ref);
+    }
+    expect_same(tree, ref);
+
+    for (const auto& [key, value] : ref) ASSERT_TRUE(tree.erase(key)) << key;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.height(), 0u);
+    EXPECT_TRUE(tree.insert(1, 2));
+    EXPECT_EQ(*tree.find(1), 2);
+}
+
+TEST(BTreeMapTest, AscendingInsertsFillLeaves) {
+    llti::HugePageArena arena(size_t{16} << 20);
+    llti::BTreeMap<int64_t> tree(&arena);
+    for (int64_t i = 0; i < 32 * 1024; ++i) tree.insert(i, i);
+    for (int64_t i = 0; i < 32 * 1024; ++i) ASSERT_EQ(*tree.find(i), i);
+    // 1024 full 576-byte leaves plus ~70 inner nodes; leaves split in half
+    // would need twice as many.
+    EXPECT_LT(arena.used(), size_t{1100} * 576);
+}
+
+TEST(BTreeMapTest, ScanFollowsLeafLinks) {
+    std::mt19937_64 rng(8);
+    llti::BTreeMap<int64_t> tree;
+    std::map<int64_t, int64_t> ref;
+    for (int i = 0; i < 20000; ++i) {
+        int64_t key = static_cast<int64_t>(rng() >> 20) - (int64_t{1} << 43);
+        tree.insert(key, i);
+        ref[key] = i;
+    }
+    for (int i = 0; i < 200; ++i) {
+        int64_t lo = static_cast<int64_t>(rng() >> 20) - (int64_t{1} << 43);
+        int64_t hi = lo + static_cast<int64_t>(rng() >> 30);
+        std::vector<int64_t> got;
+        tree.scan(lo, hi, [&](int64_t key, const int64_t& value) {
+            EXPECT_EQ(value, ref[key]);
+            got.push_back(key);
+        });
+        std::vector<int64_t> want;
+        for (auto it = ref.lower_bound(lo); it != ref.end() && it->first <= hi; ++it)
+            want.push_back(it->first);
+        ASSERT_EQ(got, want) << lo << " " << hi;
+    }
+}
+
+TEST(BTreeMapTest, BulkLoadFromSortedLookup) {
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 100000; ++i) entries.push_back({i * 2, i});
+    entries.push_back({10, -1});  // duplicate: SortedLookup::find returns the first
+    llti::SortedLookup<int64_t> sorted;
+    sorted.build(entries);
+
+    llti::HugePageArena arena(size_t{64} << 20);
+    llti::BTreeMap<int64_t> tree(&arena);
+    tree.bulk_load(sorted);
+    EXPECT_EQ(tree.size(), 100000u);
+    for (int64_t i = 0; i < 100000; ++i) {
+        ASSERT_NE(tree.find(i * 2), nullptr) << i;
+        EXPECT_EQ(*tree.find(i * 2), *sorted.find(i * 2));
+        EXPECT_EQ(tree.find(i * 2 + 1), nullptr);
+    }
+
+    // The loaded tree stays mutable.
+    std::map<int64_t, int64_t> ref;
+    tree.for_each([&](int64_t key, const int64_t& value) { ref[key] = value; });
+    std::mt19937_64 rng(6);
+    for (int op = 0; op < 50000; ++op) {
+        int64_t key = static_cast<int64_t>(rng() % 300000);
+        if (op % 2) {
+            EXPECT_EQ(tree.erase(key), ref.erase(key) == 1);
+        } else {
+            tree.insert(key, op);
+            ref[key] = op;
+        }
+    }
+    expect_same(tree, ref);
+
+    sorted.build({});
+    tree.bulk_load(sorted);
+    EXPECT_TRUE(tree.empty());
+}
@@ -0,0 +1,72 @@
+#include "llti/calibration.h"
+#include <gtest/gtest.h>
+#include <set>
+
+TEST(CalibrationTest, ChaseIsSingleCycleOverAllLines) {
+    llti::ChaseBuffer buf(64 * 1000, false);
+    ASSERT_EQ(buf.lines(), 1000u);
+
+    std::set<void*> seen;
+    void* p = buf.head();
+    for (size_t i = 0; i < buf.lines(); ++i) {
+        EXPECT_TRUE(seen.insert(p).second) << "revisited a line after " << i << " hops";
+        p = *static_cast<void**>(p);
+    }
+    EXPECT_EQ(p, buf.head());
+    EXPECT_EQ(seen.size(), buf.lines());
+}
+
+TEST(CalibrationTest, ChaseLatencyIsPositive) {
+    llti::ChaseBuffer buf(16 << 10, true);
+    double ns = buf.chase_ns(1 << 16);
+    EXPECT_GT(ns, 0.0);
+    EXPECT_LT(ns, 1000.0);
+}
+
+TEST(CalibrationTest, RunProducesMonotoneSummary) {
+    llti::Topology topo;  // no sysfs: defaults to 32K/1M/32M caches
+    auto cal = llti::MemoryCalibration::run(topo, 1 << 20, 1 << 14);
+    ASSERT_EQ(cal.curve.size(), 9u);  // 4K .. 1M
+    EXPECT_EQ(cal.curve.front().bytes, 4u << 10);
+    EXPECT_EQ(cal.curve.back().bytes, 1u << 20);
+    for (size_t i = 1; i < cal.curve.size(); ++i)
+        EXPECT_GT(cal.curve[i].bytes, cal.curve[i - 1].bytes) << "at point " << i;
+    EXPECT_EQ(cal.l1_bytes, 32u << 10);
+    EXPECT_GT(cal.l1_ns, 0.0);
+    EXPECT_GT(cal.bandwidth.read_gbs, 0.0);
+    EXPECT_GT(cal.bandwidth.write_gbs, 0.0);
+    EXPECT_LE(cal.tlb_reach_bytes, 1u << 20);
+}
+
+TEST(CalibrationTest, NoMissesWhenTableFitsInCache) {
+    for (auto layout : {llti::SearchLayout::Sorted, llti::SearchLayout::Eytzinger,
+                        llti::SearchLayout::Veb}) {
+        EXPECT_EQ(llti::expected_misses(layout, 1000, 1 << 20), 0.0);
+        EXPECT_EQ(llti::expected_misses(layout, 0, 0), 0.0);
+    }
+}
+
+TEST(CalibrationTest, MissModelOrdersLayouts) {
+    constexpr size_t N = 10'000'000;
+    constexpr size_t L2 = 2 << 20;
+    double sorted = llti::expected_misses(llti::SearchLayout::Sorted, N, L2);
+    double eytz = llti::expected_misses(llti::SearchLayout::Eytzinger, N, L2);
+    double veb = llti::expected_misses(llti::SearchLayout::Veb, N, L2);
+
+    // Eytzinger caches 8x more depths than sorted midpoints in the same space.
+    EXPECT_LT(eytz, sorted + 3);
+    EXPECT_GT(eytz, 0.0);
+    // vEB crosses a line every other depth below the cached top.
+    EXPECT_LT(veb, eytz);
+    // Larger caches never increase misses.
+    EXPECT_LE(llti::expected_misses(llti::SearchLayout::Eytzinger, N, 64 << 20), eytz);
+}
+
+TEST(CalibrationTest, PredictChargesNextLevelLatency) {
+    llti::MemoryCalibration cal;
+    cal.l2_ns = 4;
+    cal.l3_ns = 20;
+    cal.dram_ns = 100;
+    // 10 L1 misses: 4 served by L2, 4 by L3, 2 by DRAM.
+    EXPECT_DOUBLE_EQ(cal.predict_ns(10, 6, 2), 4 * 4 + 4 * 20 + 2 * 100);
+}
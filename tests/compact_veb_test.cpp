@@ -0,0 +1,82 @@
+#include "llti/compact_veb_lookup.h"
+#include "llti/veb_lookup.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+TEST(CompactVebLookupTest, FindAllInsertedKeys) {
+    llti::CompactVebLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 1000; ++i) {
+        entries.push_back({i * 3, i * 100});
+    }
+    table.build(std::move(entries));
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto* val = table.find(i * 3);
+        ASSERT_NE(val, nullptr) << "key=" << i * 3;
+        EXPECT_EQ(*val, i * 100);
+        EXPECT_EQ(table.find(i * 3 + 1), nullptr);
+    }
+    EXPECT_EQ(table.find(-1), nullptr);
+    EXPECT_EQ(table.find(3000), nullptr);
+    EXPECT_TRUE(table.far.empty());
+}
+
+TEST(CompactVebLookupTest, EmptyAndSingle) {
+    llti::CompactVebLookup<int64_t> table;
+    table.build({});
+    EXPECT_EQ(table.find(0), nullptr);
+
+    table.build({{42, 999}});
+    ASSERT_NE(table.find(42), nullptr);
+    EXPECT_EQ(*table.find(42), 999);
+    EXPECT_EQ(table.find(41), nullptr);
+    EXPECT_EQ(table.find(43), nullptr);
+}
+
+TEST(CompactVebLookupTest, NodesStaySixteenBytes) {
+    EXPECT_EQ(sizeof(llti::CompactVebLookup<int64_t>::SearchData), 16u);
+}
+
+TEST(CompactVebLookupTest, SameLayoutAsVebLookup) {
+    std::mt19937_64 rng(11);
+    for (int64_t sz : {1, 2, 3, 7, 8, 100, 1023, 1024, 1025, 70000}) {
+        std::vector<std::pair<int64_t, int64_t>> entries;
+        for (int64_t i = 0; i < sz; ++i) {
+            int64_t key = static_cast<int64_t>(rng());
+            entries.push_back({key, key});
+        }
+        llti::VebLookup<int64_t> veb;
+        veb.build(entries);
+        llti::CompactVebLookup<int64_t> compact;
+        compact.build(entries);
+
+        for (const auto& [key, val] : entries) {
+            auto* a = veb.find(key);
+            auto* b = compact.find(key);
+            ASSERT_NE(b, nullptr) << "sz=" << sz;
+            EXPECT_EQ(b - compact.vals.data(), a - veb.vals.data()) << "sz=" << sz;
+        }
+    }
+}
+
+TEST(CompactVebLookupTest, FarLinks) {
+    // 4-bit links: any offset >= 8 goes through the far table.
+    llti::CompactVebLookup<int64_t, 4> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 100000; ++i) entries.push_back({i * 2, -i});
+    entries.push_back({std::numeric_limits<int64_t>::min(), 1});
+    entries.push_back({std::numeric_limits<int64_t>::max(), 2});
+    table.build(std::move(entries));
+
+    EXPECT_FALSE(table.far.empty());
+    for (int64_t i = 0; i < 100000; ++i) {
+        auto* val = table.find(i * 2);
+        ASSERT_NE(val, nullptr) << "key=" << i * 2;
+        EXPECT_EQ(*val, -i);
+        EXPECT_EQ(table.find(i * 2 + 1), nullptr);
+    }
+    ASSERT_NE(table.find(std::numeric_limits<int64_t>::min()), nullptr);
+    EXPECT_EQ(*table.find(std::numeric_limits<int64_t>::max()), 2);
+}
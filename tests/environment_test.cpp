@@ -0,0 +1,89 @@
+#include "fake_sysfs.h"
+#include "llti/environment.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+bool mentions(const std::vector<std::string>& warnings, const std::string& needle) {
+    return std::any_of(warnings.begin(), warnings.end(),
+                       [&](const std::string& w) { return w.find(needle) != std::string::npos; });
+}
+
+}  // namespace
+
+TEST(EnvironmentTest, QuietHostHasNoWarnings) {
+    FakeSysfs f("llti_env");
+    f.write("sys/devices/system/cpu/online", "0-1");
+    f.write("sys/devices/system/cpu/isolated", "1");
+    f.write("sys/devices/system/cpu/nohz_full", "1");
+    f.write("sys/devices/system/cpu/cpu1/cpufreq/scaling_governor", "performance");
+    f.write("sys/devices/system/cpu/intel_pstate/no_turbo", "1");
+    f.write("sys/kernel/mm/transparent_hugepage/enabled", "always [madvise] never");
+    f.write("proc/cpuinfo",
+            "processor\t: 0\n"
+            "model name\t: Intel(R) Xeon(R) Platinum 8488C\n"
+            "flags\t\t: fpu tsc constant_tsc nonstop_tsc avx2\n");
+
+    auto topo = llti::Topology::discover(f.sys(), f.proc());
+    auto env = llti::BenchEnvironment::probe(topo, 1, f.sys(), f.proc());
+
+    EXPECT_EQ(env.cpu, 1);
+    EXPECT_EQ(env.cpu_model, "Intel(R) Xeon(R) Platinum 8488C");
+    EXPECT_EQ(env.governor, "performance");
+    EXPECT_EQ(env.turbo, "off");
+    EXPECT_EQ(env.thp, "madvise");
+    EXPECT_TRUE(env.isolated);
+    EXPECT_TRUE(env.nohz_full);
+    EXPECT_TRUE(env.invariant_tsc);
+    EXPECT_GT(env.tsc_hz, 0.0);
+    EXPECT_TRUE(env.warnings().empty());
+}
+
+TEST(EnvironmentTest, NoisyHostWarns) {
+    FakeSysfs f("llti_env");
+    f.write("sys/devices/system/cpu/online", "0-1");
+    f.write("sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", "powersave");
+    f.write("sys/devices/system/cpu/cpufreq/boost", "1");
+    f.write("sys/kernel/mm/transparent_hugepage/enabled", "[always] madvise never");
+    f.write("proc/cpuinfo", "model name\t: Test CPU\nflags\t\t: fpu tsc\n");
+
+    auto topo = llti::Topology::discover(f.sys(), f.proc());
+    auto env = llti::BenchEnvironment::probe(topo, 0, f.sys(), f.proc());
+
+    EXPECT_EQ(env.turbo, "on");
+    EXPECT_EQ(env.thp, "always");
+    auto w = env.warnings();
+    EXPECT_TRUE(mentions(w, "isolcpus"));
+    EXPECT_TRUE(mentions(w, "nohz_full"));
+    EXPECT_TRUE(mentions(w, "powersave"));
+    EXPECT_TRUE(mentions(w, "turbo"));
+    EXPECT_TRUE(mentions(w, "transparent_hugepage"));
+    EXPECT_TRUE(mentions(w, "TSC"));
+}
+
+TEST(EnvironmentTest, ContextCarriesEveryField) {
+    FakeSysfs f("llti_env");
+    f.write("sys/devices/system/cpu/online", "0");
+    auto topo = llti::Topology::discover(f.sys(), f.proc());
+    auto env = llti::BenchEnvironment::probe(topo, 0, f.sys(), f.proc());
+
+    auto ctx = env.context();
+    auto value = [&](const std::string& key) {
+        for (const auto& [k, v] : ctx)
+            if (k == key) return v;
+        return std::string("<missing>");
+    };
+    EXPECT_EQ(value("llti_cpu"), "0");
+    EXPECT_EQ(value("llti_governor"), "unknown");
+    EXPECT_EQ(value("llti_turbo"), "unknown");
+    EXPECT_EQ(value("llti_isolated"), "no");
+    EXPECT_NE(value("llti_tsc_ghz"), "<missing>");
+}
+
+TEST(EnvironmentTest, TscRateIsPlausible) {
+    double hz = llti::measure_tsc_hz(std::chrono::milliseconds(10));
+    EXPECT_GT(hz, 1e8);   // > 100 MHz
+    EXPECT_LT(hz, 1e10);  // < 10 GHz
+}
@@ -0,0 +1,109 @@
+#include "llti/external_builder.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+// Input and output files in TMPDIR, unique per test and process.
+class ExternalBuilderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char* tmp = std::getenv("TMPDIR");
+        base_ = std::string(tmp ? tmp : "/tmp") + "/llti-test-" + std::to_string(getpid()) + "-" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    }
+    void TearDown() override {
+        std::remove(input().c_str());
+        std::remove(output().c_str());
+    }
+
+    std::string input() const { return base_ + ".in"; }
+    std::string output() const { return base_ + ".eyt"; }
+
+    void write_input(const std::vector<llti::Record<int64_t>>& records) const {
+        FILE* f = std::fopen(input().c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        if (!records.empty())
+            std::fwrite(records.data(), sizeof(records[0]), records.size(), f);
+        std::fclose(f);
+    }
+
+    std::string base_;
+};
+
+}  // namespace
+
+TEST_F(ExternalBuilderTest, ManyRunsMatchEveryKey) {
+    std::vector<llti::Record<int64_t>> records;
+    for (int64_t i = 0; i < 100000; ++i) records.push_back({i * 3, i});
+    std::shuffle(records.begin(), records.end(), std::mt19937_64(7));
+    write_input(records);
+
+    // 64 KB of buffers: 2048 records per run plus scratch, so 49 runs.
+    llti::ExternalBuildOptions options;
+    options.memory_budget = 64 << 10;
+    auto stats = llti::build_eytzinger_file<int64_t>(input(), output(), options);
+    EXPECT_EQ(stats.records, 100000u);
+    EXPECT_EQ(stats.runs, 49u);
+
+    llti::EytzingerFile<int64_t> table(output());
+    ASSERT_EQ(table.size(), 100000u);
+    for (int64_t i = 0; i < 100000; ++i) {
+        auto* val = table.find(i * 3);
+        ASSERT_NE(val, nullptr) << i;
+        EXPECT_EQ(*val, i);
+        EXPECT_EQ(table.find(i * 3 + 1), nullptr);
+    }
+    EXPECT_EQ(table.find(-1), nullptr);
+}
+
+TEST_F(ExternalBuilderTest, MatchesInMemoryBuildWithNegativeAndDuplicateKeys) {
+    std::mt19937_64 rng(11);
+    std::vector<llti::Record<int64_t>> records;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 20000; ++i) {
+        // Full 64-bit range for all four radix digits, plus repeated keys.
+        int64_t key = i % 5 == 0 ? int64_t(i % 97) - 48 : static_cast<int64_t>(rng());
+        records.push_back({key, i});
+        entries.push_back({key, i});
+    }
+    write_input(records);
+    llti::ExternalBuildOptions options;
+    options.memory_budget = 32 << 10;
+    llti::build_eytzinger_file<int64_t>(input(), output(), options);
+
+    llti::EytzingerLookup<int64_t> expected;
+    expected.build(entries);
+    llti::EytzingerFile<int64_t> table(output());
+    ASSERT_EQ(table.size(), expected.n);
+    for (const auto& r : records) {
+        int64_t key = r.key;
+        auto* val = table.find(key);
+        ASSERT_NE(val, nullptr) << key;
+        // A duplicated key may resolve to any of its records.
+        EXPECT_EQ(records[*val].key, key);
+        EXPECT_EQ(records[*expected.find(key)].key, key);
+    }
+}
+
+TEST_F(ExternalBuilderTest, EmptyInput) {
+    write_input({});
+    auto stats = llti::build_eytzinger_file<int64_t>(input(), output());
+    EXPECT_EQ(stats.records, 0u);
+    EXPECT_EQ(stats.runs, 0u);
+    llti::EytzingerFile<int64_t> table(output());
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_EQ(table.find(0), nullptr);
+}
+
+TEST_F(ExternalBuilderTest, MissingInputThrows) {
+    EXPECT_THROW(llti::build_eytzinger_file<int64_t>(input(), output()), std::system_error);
+    EXPECT_THROW(llti::EytzingerFile<int64_t>{output()}, std::system_error);
+}
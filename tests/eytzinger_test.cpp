@@ -1,5 +1,7 @@
 #include "llti/eytzinger_lookup.h"
 #include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <limits>
 #include <random>
 
 TEST(EytzingerLookupTest, FindAllInsertedKeys) {
@@ -137,3 +139,57 @@ TEST(EytzingerLookupTest, LargeRandomDataset) {
         EXPECT_EQ(*val, expected);
     }
 }
+
+template <size_t Lanes, size_t Vectors>
+static void expect_simd_matches_find(const llti::EytzingerLookup<int64_t>& table,
+                                     const std::vector<int64_t>& targets) {
+    std::vector<const int64_t*> out(targets.size());
+    table.find_simd<Lanes, Vectors>(targets.data(), out.data(), targets.size());
+    for (size_t q = 0; q < targets.size(); ++q) {
+        ASSERT_EQ(out[q], table.find(targets[q]))
+            << "lanes=" << Lanes << " vectors=" << Vectors << " n=" << table.n << " key=" << targets[q];
+    }
+}
+
+TEST(EytzingerLookupTest, FindSimdMatchesFind) {
+    std::mt19937_64 rng(7);
+    // Sizes around complete-tree boundaries, where the last level is empty,
+    // one node, or full.
+    for (int64_t sz : {0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1023, 1024, 1025, 50000}) {
+        llti::EytzingerLookup<int64_t> table;
+        std::vector<std::pair<int64_t, int64_t>> entries;
+        for (int64_t i = 0; i < sz; ++i) entries.push_back({i * 4 - 1000, i});
+        table.build(std::move(entries));
+
+        // Hits, misses between keys, both ends and out-of-range extremes;
+        // 203 targets so every lane/vector combination leaves a tail.
+        std::vector<int64_t> targets = {std::numeric_limits<int64_t>::min(),
+                                        std::numeric_limits<int64_t>::max(), -1001, sz * 4 - 1000};
+        while (targets.size() < 203) {
+            int64_t key = sz > 0 ? static_cast<int64_t>(rng() % sz) * 4 - 1000 : 0;
+            targets.push_back(key + static_cast<int64_t>(rng() % 2));
+        }
+        expect_simd_matches_find<4, 1>(table, targets);
+        expect_simd_matches_find<4, 4>(table, targets);
+        expect_simd_matches_find<8, 1>(table, targets);
+        expect_simd_matches_find<8, 2>(table, targets);
+    }
+}
+
+TEST(EytzingerLookupTest, SearchPathEndingInThirtyThreeRightTurns) {
+    // A 2^34 - 1 key array, mapped sparse: the search touches one page per
+    // level and every other key reads as zero. With the root key as the
+    // target the path turns left once, then right 33 times, so the final
+    // index has 33 trailing ones and the walk back up must count past bit 31.
+    const size_t n = (size_t{1} << 34) - 1;
+    const size_t bytes = (n + 1) * sizeof(int64_t);
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) GTEST_SKIP() << "cannot reserve 128 GB of address space";
+    auto* keys = static_cast<int64_t*>(p);
+    keys[1] = 5;
+    EXPECT_EQ(llti::eytzinger_search(keys, n, 5), 1u);
+    EXPECT_EQ(llti::eytzinger_search(keys, n, 0), n / 2 + 1);  // leftmost zero key
+    EXPECT_EQ(llti::eytzinger_search(keys, n, 6), 0u);
+    munmap(p, bytes);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// A throwaway /sys + /proc tree under the temp directory, removed again on
+// destruction. Pass sys() and proc() where the code under test takes roots.
+class FakeSysfs {
+public:
+    explicit FakeSysfs(const std::string& prefix) {
+        root_ = std::filesystem::temp_directory_path() /
+                (prefix + "_" + std::to_string(::getpid()) + "_" + std::to_string(counter_++));
+        std::filesystem::create_directories(root_);
+    }
+    ~FakeSysfs() { std::filesystem::remove_all(root_); }
+    FakeSysfs(const FakeSysfs&) = delete;
+    FakeSysfs& operator=(const FakeSysfs&) = delete;
+
+    void write(const std::string& rel, const std::string& content) {
+        std::filesystem::path p = root_ / rel;
+        std::filesystem::create_directories(p.parent_path());
+        std::ofstream(p) << content << "\n";
+    }
+
+    std::string sys() const { return (root_ / "sys").string(); }
+    std::string proc() const { return (root_ / "proc").string(); }
+
+private:
+    std::filesystem::path root_;
+    static inline int counter_ = 0;
+};
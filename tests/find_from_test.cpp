@@ -0,0 +1,41 @@
+#include "llti/eytzinger_lookup.h"
+#include "llti/sorted_lookup.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+// find_from agrees with find on every layout that has a Cursor.
+template <class Table>
+class FindFromTest : public ::testing::Test {};
+
+using CursorLayouts = ::testing::Types<llti::SortedLookup<int64_t>, llti::EytzingerLookup<int64_t>>;
+TYPED_TEST_SUITE(FindFromTest, CursorLayouts);
+
+TYPED_TEST(FindFromTest, MatchesFind) {
+    TypeParam table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 5000; ++i) entries.push_back({i * 3, i});
+    table.build(std::move(entries));
+
+    // Monotone sweep, short random walk and uniform jumps, hits and misses.
+    std::mt19937_64 rng(3);
+    std::vector<int64_t> targets;
+    for (int64_t t = -5; t < 15010; t += 1 + static_cast<int64_t>(rng() % 4)) targets.push_back(t);
+    int64_t walk = 7500;
+    for (int q = 0; q < 5000; ++q) targets.push_back(walk += static_cast<int64_t>(rng() % 61) - 30);
+    for (int q = 0; q < 5000; ++q) targets.push_back(static_cast<int64_t>(rng() % 16000) - 500);
+    targets.push_back(std::numeric_limits<int64_t>::min());
+    targets.push_back(std::numeric_limits<int64_t>::max());
+    targets.push_back(0);
+
+    typename TypeParam::Cursor cursor;
+    for (int64_t t : targets) ASSERT_EQ(table.find_from(cursor, t), table.find(t)) << "target=" << t;
+}
+
+TYPED_TEST(FindFromTest, EmptyTable) {
+    TypeParam table;
+    table.build({});
+    typename TypeParam::Cursor cursor;
+    EXPECT_EQ(table.find_from(cursor, 0), nullptr);
+}
@@ -0,0 +1,88 @@
+#include "llti/hot_key_lookup.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+TEST(HotKeyLookupTest, FindAllInsertedKeys) {
+    llti::HotKeyLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    std::vector<double> weights;
+    for (int64_t i = 0; i < 1000; ++i) {
+        entries.push_back({i * 3, i * 100});
+        weights.push_back(static_cast<double>(i % 7));
+    }
+    table.build(std::move(entries), weights, 64);
+
+    EXPECT_EQ(table.hot.n, 64u);
+    EXPECT_EQ(table.main.n, 1000u);
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto* val = table.find(i * 3);
+        ASSERT_NE(val, nullptr) << "key=" << i * 3;
+        EXPECT_EQ(*val, i * 100);
+        EXPECT_EQ(table.find(i * 3 + 1), nullptr);
+    }
+}
+
+TEST(HotKeyLookupTest, HeaviestKeysAreHot) {
+    llti::HotKeyLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    std::vector<double> weights;
+    for (int64_t i = 0; i < 100; ++i) {
+        entries.push_back({i, i});
+        weights.push_back(i >= 90 ? 10.0 : 0.0);
+    }
+    table.build(std::move(entries), weights, 32);
+
+    // Only the ten weighted keys qualify, and they carry all the weight.
+    EXPECT_EQ(table.hot.n, 10u);
+    EXPECT_DOUBLE_EQ(table.hot_weight_fraction, 1.0);
+    for (int64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(table.hot.find(i) != nullptr, i >= 90) << "key=" << i;
+        ASSERT_NE(table.find(i), nullptr);
+    }
+}
+
+TEST(HotKeyLookupTest, BuildFromTrace) {
+    llti::HotKeyLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 1000; ++i) entries.push_back({i * 10, -i});
+    // Key 50 three times, key 70 twice, 12345 is not a key.
+    std::vector<int64_t> trace = {50, 70, 50, 12345, 70, 50, 990};
+    table.build_from_trace(std::move(entries), trace, 2);
+
+    EXPECT_EQ(table.hot.n, 2u);
+    EXPECT_NE(table.hot.find(50), nullptr);
+    EXPECT_NE(table.hot.find(70), nullptr);
+    EXPECT_DOUBLE_EQ(table.hot_weight_fraction, 5.0 / 6.0);
+    ASSERT_NE(table.find(990), nullptr);
+    EXPECT_EQ(*table.find(990), -99);
+}
+
+TEST(HotKeyLookupTest, EmptyAndMismatchedWeights) {
+    llti::HotKeyLookup<int64_t> table;
+    table.build({}, {});
+    EXPECT_EQ(table.find(0), nullptr);
+    EXPECT_THROW(table.build({{1, 1}}, {}), std::invalid_argument);
+}
+
+TEST(HotKeyLookupTest, MatchesEytzingerOnRandomKeys) {
+    constexpr int N = 50000;
+    std::mt19937_64 rng(5);
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    std::vector<double> weights;
+    for (int i = 0; i < N; ++i) {
+        int64_t key = static_cast<int64_t>(rng());
+        entries.push_back({key, key / 3});
+        weights.push_back(1.0 / (1 + i));  // Zipf(1) over insertion order
+    }
+    llti::EytzingerLookup<int64_t> reference;
+    reference.build(entries);
+    llti::HotKeyLookup<int64_t> table;
+    table.build(entries, weights, 1000);
+
+    for (const auto& [key, val] : entries) {
+        ASSERT_NE(table.find(key), nullptr);
+        EXPECT_EQ(*table.find(key), *reference.find(key));
+        EXPECT_EQ(table.find(key + 1) == nullptr, reference.find(key + 1) == nullptr);
+    }
+}
@@ -0,0 +1,107 @@
+#include "llti/interpolation_lookup.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace {
+
+// Checks every stored key and a neighbour of each against std::lower_bound.
+void expect_matches_sorted(std::vector<std::pair<int64_t, int64_t>> entries) {
+    llti::InterpolationLookup<int64_t> table;
+    table.build(entries);
+    for (const auto& [key, val] : entries) {
+        auto* found = table.find(key);
+        ASSERT_NE(found, nullptr) << "key=" << key;
+        EXPECT_EQ(table.keys[found - table.vals.data()], key);
+        for (int64_t probe : {key - 1, key + 1}) {
+            if ((probe < key) != (key - 1 < key)) continue;  // overflow
+            bool present = std::binary_search(table.keys.begin(), table.keys.end(), probe);
+            EXPECT_EQ(table.find(probe) != nullptr, present) << "probe=" << probe;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(InterpolationLookupTest, FindAllInsertedKeys) {
+    llti::InterpolationLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 1000; ++i) {
+        entries.push_back({i * 3, i * 100});
+    }
+    table.build(std::move(entries));
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto* val = table.find(i * 3);
+        ASSERT_NE(val, nullptr) << "key=" << i * 3;
+        EXPECT_EQ(*val, i * 100);
+        EXPECT_EQ(table.find(i * 3 + 1), nullptr);
+    }
+    EXPECT_EQ(table.find(-1), nullptr);
+    EXPECT_EQ(table.find(3000), nullptr);
+}
+
+TEST(InterpolationLookupTest, EmptyAndSingle) {
+    llti::InterpolationLookup<int64_t> table;
+    table.build({});
+    EXPECT_EQ(table.find(0), nullptr);
+
+    table.build({{42, 999}});
+    ASSERT_NE(table.find(42), nullptr);
+    EXPECT_EQ(*table.find(42), 999);
+    EXPECT_EQ(table.find(41), nullptr);
+    EXPECT_EQ(table.find(43), nullptr);
+}
+
+TEST(InterpolationLookupTest, DuplicateKeys) {
+    llti::InterpolationLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries(100, {7, 1});
+    entries.push_back({9, 2});
+    table.build(std::move(entries));
+    ASSERT_NE(table.find(7), nullptr);
+    EXPECT_EQ(*table.find(7), 1);
+    ASSERT_NE(table.find(9), nullptr);
+    EXPECT_EQ(table.find(8), nullptr);
+}
+
+TEST(InterpolationLookupTest, UniformRandomKeys) {
+    std::mt19937_64 rng(12345);
+    std::vector<std::pair<int64_t, int64_t>> entries(100000);
+    for (auto& [k, v] : entries) k = v = static_cast<int64_t>(rng());
+    expect_matches_sorted(std::move(entries));
+}
+
+TEST(InterpolationLookupTest, ExtremeKeys) {
+    constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+    constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+    std::vector<std::pair<int64_t, int64_t>> entries = {{kMin, 0}, {kMax, 0}};
+    for (int64_t i = -500; i < 500; ++i) entries.push_back({i * 1000, i});
+    expect_matches_sorted(std::move(entries));
+}
+
+TEST(InterpolationLookupTest, ClusteredKeys) {
+    std::mt19937_64 rng(3);
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int c = 0; c < 50; ++c) {
+        int64_t center = static_cast<int64_t>(rng() >> 1);
+        for (int i = 0; i < 1000; ++i) entries.push_back({center + static_cast<int64_t>(rng() % 5000), c});
+    }
+    expect_matches_sorted(std::move(entries));
+}
+
+TEST(InterpolationLookupTest, AdversarialOutlier) {
+    // Dense run plus one huge key: every interpolation guess lands at the
+    // low end, so the guard must hand over to binary search.
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 100000; ++i) entries.push_back({i * 2, i});
+    entries.push_back({std::numeric_limits<int64_t>::max() / 2, -1});
+    expect_matches_sorted(std::move(entries));
+}
+
+TEST(InterpolationLookupTest, ExponentialKeys) {
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int i = 0; i < 62; ++i)
+        for (int j = 0; j < 100; ++j) entries.push_back({(int64_t{1} << i) + j, i});
+    expect_matches_sorted(std::move(entries));
+}
@@ -0,0 +1,103 @@
+#include "llti/eytzinger_lookup.h"
+#include "llti/lookup_service.h"
+#include "llti/sorted_lookup.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(MpmcRingTest, FifoFullAndEmpty) {
+    llti::MpmcRing<int> ring(3);  // rounds up to 4
+    EXPECT_EQ(ring.capacity(), 4u);
+    int out = 0;
+    EXPECT_FALSE(ring.try_pop(out));
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push(i));
+    EXPECT_FALSE(ring.try_push(99));
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(ring.try_pop(out));
+    // Wraps around.
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_TRUE(ring.try_push(round));
+        ASSERT_TRUE(ring.try_pop(out));
+        EXPECT_EQ(out, round);
+    }
+}
+
+TEST(MpmcRingTest, ConcurrentProducersAndConsumers) {
+    constexpr int kProducers = 3, kConsumers = 2, kPerProducer = 50000;
+    llti::MpmcRing<int> ring(64);
+    std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i)
+                while (!ring.try_push(p * kPerProducer + i)) std::this_thread::yield();
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            int item;
+            while (consumed.load() < kProducers * kPerProducer) {
+                if (ring.try_pop(item)) {
+                    seen[item].fetch_add(1);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    for (auto& s : seen) ASSERT_EQ(s.load(), 1);
+}
+
+template <class Table>
+static void expect_service_matches_find() {
+    std::mt19937_64 rng(31);
+    std::vector<std::pair<int64_t, int64_t>> entries(20000);
+    for (auto& [k, v] : entries) k = v = static_cast<int64_t>(rng() >> 1);
+    Table table;
+    table.build(entries);
+
+    llti::LookupService<Table> service(table, 256);
+    // Four clients, each keeping a window of requests in flight.
+    std::vector<std::thread> clients;
+    std::atomic<int> mismatches{0};
+    for (int c = 0; c < 4; ++c) {
+        clients.emplace_back([&, c] {
+            std::mt19937_64 crng(c);
+            constexpr size_t kWindow = 16;
+            typename llti::LookupService<Table>::Completion slots[kWindow];
+            int64_t keys[kWindow];
+            for (int round = 0; round < 200; ++round) {
+                for (size_t i = 0; i < kWindow; ++i) {
+                    keys[i] = entries[crng() % entries.size()].first + static_cast<int64_t>(i & 1);
+                    while (!service.submit(keys[i], slots[i])) std::this_thread::yield();
+                }
+                for (size_t i = 0; i < kWindow; ++i)
+                    if (slots[i].wait() != table.find(keys[i])) mismatches.fetch_add(1);
+            }
+            if (service.find(entries[0].first) != table.find(entries[0].first)) mismatches.fetch_add(1);
+        });
+    }
+    for (auto& t : clients) t.join();
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(service.served(), 4u * (200 * 16 + 1));
+    EXPECT_GT(service.batches(), 0u);
+}
+
+TEST(LookupServiceTest, BatchedSimdPathMatchesFind) {
+    static_assert(llti::LookupService<llti::EytzingerLookup<int64_t>>::kInterleaved);
+    expect_service_matches_find<llti::EytzingerLookup<int64_t>>();
+}
+
+TEST(LookupServiceTest, ScalarPathMatchesFind) {
+    static_assert(!llti::LookupService<llti::SortedLookup<int64_t>>::kInterleaved);
+    expect_service_matches_find<llti::SortedLookup<int64_t>>();
+}
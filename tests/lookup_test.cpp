@@ -95,3 +95,13 @@ TEST(SortedLookupTest, LargeRandomDataset) {
         EXPECT_EQ(*val, expected);
     }
 }
+
+TEST(SortedLookupTest, RebuildWithReplacesAllDuplicates) {
+    llti::SortedLookup<int64_t> table;
+    table.build({{5, 100}, {5, 200}, {7, 1}, {7, 2}, {9, 3}});
+    table.rebuild_with({{5, 500}}, {7});
+    EXPECT_EQ(table.keys.size(), 2u);
+    EXPECT_EQ(*table.find(5), 500);
+    EXPECT_EQ(table.find(7), nullptr);
+    EXPECT_EQ(*table.find(9), 3);
+}
@@ -0,0 +1,95 @@
+#include "llti/order_book.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+TEST(OrderMapTest, InsertFindErase) {
+    llti::OrderMap map;
+    for (uint64_t id = 1; id <= 1000; ++id) map.insert(id, static_cast<uint32_t>(id * 2));
+
+    for (uint64_t id = 1; id <= 1000; ++id) {
+        uint32_t* v = map.find(id);
+        ASSERT_NE(v, nullptr) << "id=" << id;
+        EXPECT_EQ(*v, id * 2);
+    }
+    EXPECT_EQ(map.find(1001), nullptr);
+
+    map.erase(500);
+    EXPECT_EQ(map.find(500), nullptr);
+    ASSERT_NE(map.find(501), nullptr);
+}
+
+TEST(OrderMapTest, InsertExistingKeyUpdates) {
+    llti::OrderMap map;
+    map.insert(42, 1);
+    map.insert(42, 7);
+    ASSERT_NE(map.find(42), nullptr);
+    EXPECT_EQ(*map.find(42), 7u);
+}
+
+TEST(OrderMapTest, TombstoneIsReused) {
+    llti::OrderMap map;
+    map.insert(7, 1);
+    map.erase(7);
+    map.insert(7, 2);
+    ASSERT_NE(map.find(7), nullptr);
+    EXPECT_EQ(*map.find(7), 2u);
+}
+
+TEST(OrderBookTest, AddCancelTracksVolume) {
+    auto book = std::make_unique<llti::OrderBook>(10'000, 15'000);
+    book->add_order(1, 10'500, 100);
+    book->add_order(2, 10'500, 50);
+    book->add_order(3, 12'000, 10);
+    EXPECT_EQ(book->get_volume_at_price(10'500), 150);
+    EXPECT_EQ(book->get_volume_at_price(12'000), 10);
+    EXPECT_EQ(book->num_orders(), 3u);
+
+    book->cancel_order(1);
+    EXPECT_EQ(book->get_volume_at_price(10'500), 50);
+    EXPECT_EQ(book->num_orders(), 2u);
+
+    // Unknown and already-cancelled ids are ignored.
+    book->cancel_order(1);
+    book->cancel_order(99);
+    EXPECT_EQ(book->get_volume_at_price(10'500), 50);
+    EXPECT_EQ(book->num_orders(), 2u);
+}
+
+TEST(OrderBookTest, ModifyMovesVolume) {
+    auto book = std::make_unique<llti::OrderBook>(10'000, 15'000);
+    book->add_order(1, 10'000, 100);
+    book->modify_order(1, 15'000, 30);
+    EXPECT_EQ(book->get_volume_at_price(10'000), 0);
+    EXPECT_EQ(book->get_volume_at_price(15'000), 30);
+    book->cancel_order(1);
+    EXPECT_EQ(book->get_volume_at_price(15'000), 0);
+}
+
+TEST(OrderBookTest, ChurnMatchesReference) {
+    // Random add/cancel churn against a std::unordered_map reference; the
+    // free list must keep the pool bounded well below MAX_ORDERS.
+    auto book = std::make_unique<llti::OrderBook>(0, 99);
+    std::unordered_map<uint64_t, std::pair<int64_t, int32_t>> ref;
+    std::mt19937_64 rng(7);
+    uint64_t next_id = 1;
+    for (int step = 0; step < 200'000; ++step) {
+        if (ref.size() < 1000 || rng() % 2 == 0) {
+            int64_t price = static_cast<int64_t>(rng() % 100);
+            int32_t qty = static_cast<int32_t>(rng() % 500 + 1);
+            book->add_order(next_id, price, qty);
+            ref[next_id++] = {price, qty};
+        } else {
+            auto it = ref.begin();
+            std::advance(it, rng() % std::min<size_t>(ref.size(), 16));
+            book->cancel_order(it->first);
+            ref.erase(it);
+        }
+    }
+
+    std::vector<int32_t> expected(100, 0);
+    for (const auto& [id, po] : ref) expected[po.first] += po.second;
+    for (int64_t p = 0; p < 100; ++p) EXPECT_EQ(book->get_volume_at_price(p), expected[p]);
+    EXPECT_EQ(book->num_orders(), ref.size());
+}
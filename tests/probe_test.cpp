@@ -0,0 +1,100 @@
+// Probes are compiled in for this translation unit only. It must not
+// include the instrumented lookup headers: their inline find() would then
+// differ between translation units.
+#ifndef LLTI_PROBES
+#define LLTI_PROBES
+#endif
+#include "llti/probe.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+int probed_work(int x) {
+    LLTI_PROBE_SCOPE(Work);
+    if (x < 0) return 0;  // early return still closes the span
+    LLTI_PROBE(WorkMid);
+    return x * 2;
+}
+
+llti::probe::Dump dump_all() {
+    std::stringstream ss;
+    char* buf = nullptr;
+    size_t len = 0;
+    std::FILE* f = open_memstream(&buf, &len);
+    llti::probe::dump(f, 3e9);
+    std::fclose(f);
+    ss.write(buf, static_cast<std::streamsize>(len));
+    std::free(buf);
+    return llti::probe::read_dump(ss);
+}
+
+}  // namespace
+
+TEST(ProbeTest, RingKeepsMostRecentSamples) {
+    llti::probe::Ring ring(0, 4);
+    static const char* names[] = {"a", "b", "c", "d", "e", "f"};
+    for (int i = 0; i < 6; ++i) ring.push(names[i], 100 + i, 0);
+    auto samples = ring.snapshot();
+    ASSERT_EQ(samples.size(), 4u);
+    EXPECT_STREQ(samples.front().name, "c");
+    EXPECT_EQ(samples.front().tsc, 102u);
+    EXPECT_STREQ(samples.back().name, "f");
+}
+
+TEST(ProbeTest, ScopeRecordsBeginAndEndOnEveryPath) {
+    llti::probe::Registry::instance().clear();
+    llti::probe::init_thread(1024);
+    probed_work(3);
+    probed_work(-1);
+
+    auto spans = llti::probe::reconstruct_spans(dump_all());
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_EQ(spans[0].name, "Work");
+    EXPECT_EQ(spans[0].ticks.size(), 2u);
+}
+
+TEST(ProbeTest, RingsOutliveTheirThreads) {
+    llti::probe::Registry::instance().clear();
+    std::thread([] {
+        for (int i = 0; i < 10; ++i) probed_work(i);
+    }).join();
+
+    auto dump = dump_all();
+    EXPECT_DOUBLE_EQ(dump.tsc_hz, 3e9);
+    auto spans = llti::probe::reconstruct_spans(dump);
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_EQ(spans[0].ticks.size(), 10u);
+}
+
+TEST(ProbeTest, ReconstructPairsPerThread) {
+    // Interleaved threads; an unmatched Begin is superseded by the next one,
+    // and an End with no open Begin is dropped.
+    std::istringstream in(
+        "# llti-probes v1 tsc_hz=1000000000\n"
+        "0 100 10 BookAddBegin\n"
+        "1 105 0 BookAddBegin\n"
+        "0 130 25 BookAddEnd\n"
+        "1 150 0 BookAddEnd\n"
+        "0 200 0 BookAddBegin\n"
+        "0 210 0 BookAddBegin\n"
+        "0 214 0 BookAddEnd\n"
+        "0 300 0 BookCancelEnd\n");
+    auto dump = llti::probe::read_dump(in);
+    EXPECT_DOUBLE_EQ(dump.tsc_hz, 1e9);
+    ASSERT_EQ(dump.records.size(), 8u);
+
+    auto spans = llti::probe::reconstruct_spans(dump);
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_EQ(spans[0].name, "BookAdd");
+    EXPECT_EQ(spans[0].ticks, (std::vector<uint64_t>{30, 45, 4}));
+    EXPECT_EQ(spans[0].pmc[0], 15u);
+
+    auto custom = llti::probe::reconstruct_spans(dump, {{"BookAddBegin", "BookCancelEnd"}});
+    ASSERT_EQ(custom.size(), 1u);
+    EXPECT_EQ(custom[0].name, "BookAddBegin->BookCancelEnd");
+    EXPECT_EQ(custom[0].ticks, (std::vector<uint64_t>{90}));
+}
@@ -0,0 +1,64 @@
+#include "llti/eytzinger_lookup.h"
+#include "llti/sorted_lookup.h"
+#include "llti/veb_lookup.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+// rebuild_with behaves the same on every layout that has it.
+template <class Table>
+class RebuildWithTest : public ::testing::Test {};
+
+using RebuildLayouts = ::testing::Types<llti::SortedLookup<int64_t>, llti::EytzingerLookup<int64_t>,
+                                        llti::VebLookup<int64_t>>;
+TYPED_TEST_SUITE(RebuildWithTest, RebuildLayouts);
+
+TYPED_TEST(RebuildWithTest, MatchesFullBuild) {
+    std::mt19937_64 rng(5);
+    std::map<int64_t, int64_t> reference;
+    while (reference.size() < 3000)
+        reference[static_cast<int64_t>(rng() % 10000)] = static_cast<int64_t>(rng());
+    TypeParam table;
+    table.build({reference.begin(), reference.end()});
+
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::pair<int64_t, int64_t>> upserts;
+        std::vector<int64_t> deletes;
+        for (int i = 0; i < 200; ++i) {
+            int64_t key = static_cast<int64_t>(rng() % 10000);
+            if (rng() % 2) {
+                upserts.push_back({key, static_cast<int64_t>(rng())});
+            } else {
+                deletes.push_back(key);
+                reference.erase(key);
+            }
+        }
+        for (const auto& [key, value] : upserts) reference[key] = value;  // upserts win over deletes
+        table.rebuild_with(upserts, deletes);
+
+        for (int64_t key = -1; key <= 10000; ++key) {
+            auto it = reference.find(key);
+            const int64_t* val = table.find(key);
+            if (it == reference.end()) {
+                EXPECT_EQ(val, nullptr) << "key=" << key;
+            } else {
+                ASSERT_NE(val, nullptr) << "key=" << key;
+                EXPECT_EQ(*val, it->second);
+            }
+        }
+    }
+}
+
+TYPED_TEST(RebuildWithTest, FromAndToEmpty) {
+    TypeParam table;
+    table.build({});
+    table.rebuild_with({{3, 30}, {1, 10}, {3, 33}}, {});
+    ASSERT_NE(table.find(3), nullptr);
+    EXPECT_EQ(*table.find(3), 33);  // last upsert of a key wins
+    EXPECT_EQ(*table.find(1), 10);
+
+    table.rebuild_with({}, {1, 3, 5});
+    EXPECT_EQ(table.find(1), nullptr);
+    EXPECT_EQ(table.find(3), nullptr);
+}
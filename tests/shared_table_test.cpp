@@ -0,0 +1,100 @@
+#include "llti/shared_table.h"
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <string>
+#include <system_error>
+
+namespace {
+
+// Unique per test and process, so parallel test runs do not collide.
+class SharedTableTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        name_ = "llti-test-" + std::to_string(getpid()) + "-" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    }
+    void TearDown() override { llti::SharedTablePublisher<int64_t>::remove(name_); }
+
+    static std::vector<std::pair<int64_t, int64_t>> entries(int64_t n, int64_t scale) {
+        std::vector<std::pair<int64_t, int64_t>> out;
+        for (int64_t i = 0; i < n; ++i) out.push_back({i * 3, i * scale});
+        return out;
+    }
+
+    std::string name_;
+};
+
+}  // namespace
+
+TEST_F(SharedTableTest, ReaderSeesPublishedTable) {
+    llti::SharedTablePublisher<int64_t> publisher(name_);
+    EXPECT_EQ(publisher.publish(entries(1000, 10)), 1u);
+
+    llti::SharedTableReader<int64_t> reader(name_);
+    EXPECT_EQ(reader.generation(), 1u);
+    EXPECT_EQ(reader.size(), 1000u);
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto* val = reader.find(i * 3);
+        ASSERT_NE(val, nullptr) << i;
+        EXPECT_EQ(*val, i * 10);
+        EXPECT_EQ(reader.find(i * 3 + 1), nullptr);
+    }
+}
+
+TEST_F(SharedTableTest, RefreshSwitchesToNewGeneration) {
+    llti::SharedTablePublisher<int64_t> publisher(name_);
+    publisher.publish(entries(100, 1));
+    llti::SharedTableReader<int64_t> reader(name_);
+    EXPECT_FALSE(reader.refresh());
+
+    // Two more publishes unlink generation 1, which the reader still maps.
+    publisher.publish(entries(200, 2));
+    publisher.publish(entries(300, 3));
+    EXPECT_EQ(*reader.find(30), 10);
+    EXPECT_EQ(reader.find(600), nullptr);
+
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_EQ(reader.generation(), 3u);
+    EXPECT_EQ(*reader.find(30), 30);
+    EXPECT_EQ(*reader.find(600), 600);
+}
+
+TEST_F(SharedTableTest, ReaderInAnotherProcess) {
+    llti::SharedTablePublisher<int64_t> publisher(name_);
+    publisher.publish(entries(5000, 7));
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        int bad = 0;
+        try {
+            llti::SharedTableReader<int64_t> reader(name_);
+            for (int64_t i = 0; i < 5000; ++i) {
+                auto* val = reader.find(i * 3);
+                bad += val == nullptr || *val != i * 7;
+            }
+        } catch (...) {
+            bad = 1;
+        }
+        _exit(bad == 0 ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST_F(SharedTableTest, EmptyAndUnpublished) {
+    EXPECT_THROW(llti::SharedTableReader<int64_t> reader(name_), std::system_error);
+
+    llti::SharedTablePublisher<int64_t> publisher(name_);
+    llti::SharedTableReader<int64_t> reader(name_);
+    EXPECT_EQ(reader.generation(), 0u);
+    EXPECT_EQ(reader.find(0), nullptr);
+
+    publisher.publish({});
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_EQ(reader.size(), 0u);
+    EXPECT_EQ(reader.find(0), nullptr);
+}
@@ -0,0 +1,116 @@
+#include "llti/static_hash_lookup.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+TEST(StaticHashLookupTest, FindAllInsertedKeys) {
+    llti::StaticHashLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 1000; ++i) {
+        entries.push_back({i * 3, i * 100});
+    }
+    table.build(std::move(entries));
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto* val = table.find(i * 3);
+        ASSERT_NE(val, nullptr) << "key=" << i * 3;
+        EXPECT_EQ(*val, i * 100);
+    }
+}
+
+TEST(StaticHashLookupTest, MissingKeysReturnNullptr) {
+    llti::StaticHashLookup<int64_t> table;
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t i = 0; i < 100; ++i) {
+        entries.push_back({i * 2, i});
+    }
+    table.build(std::move(entries));
+
+    for (int64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(table.find(i * 2 + 1), nullptr);
+    }
+    EXPECT_EQ(table.find(-1), nullptr);
+    EXPECT_EQ(table.find(table.empty_key), nullptr);
+}
+
+TEST(StaticHashLookupTest, EmptyTable) {
+    llti::StaticHashLookup<int64_t> table;
+    table.build({});
+    EXPECT_EQ(table.find(0), nullptr);
+    EXPECT_EQ(table.find(std::numeric_limits<int64_t>::min()), nullptr);
+}
+
+TEST(StaticHashLookupTest, SingleElement) {
+    llti::StaticHashLookup<int64_t> table;
+    table.build({{42, 999}});
+    ASSERT_NE(table.find(42), nullptr);
+    EXPECT_EQ(*table.find(42), 999);
+    EXPECT_EQ(table.find(41), nullptr);
+}
+
+TEST(StaticHashLookupTest, DuplicateKeysKeepLast) {
+    llti::StaticHashLookup<int64_t> table;
+    table.build({{5, 100}, {5, 200}, {10, 300}});
+    EXPECT_EQ(table.n, 2u);
+    ASSERT_NE(table.find(5), nullptr);
+    EXPECT_EQ(*table.find(5), 200);
+    ASSERT_NE(table.find(10), nullptr);
+    EXPECT_EQ(*table.find(10), 300);
+}
+
+TEST(StaticHashLookupTest, SentinelValuedKeysAreStored) {
+    // INT64_MIN is the default empty marker; the build must pick another.
+    constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+    llti::StaticHashLookup<int64_t> table;
+    table.build({{kMin, 1}, {kMin + 1, 2}, {0, 3}});
+    EXPECT_NE(table.empty_key, kMin);
+    EXPECT_NE(table.empty_key, kMin + 1);
+    ASSERT_NE(table.find(kMin), nullptr);
+    EXPECT_EQ(*table.find(kMin), 1);
+    ASSERT_NE(table.find(kMin + 1), nullptr);
+    EXPECT_EQ(*table.find(kMin + 1), 2);
+    EXPECT_EQ(table.find(table.empty_key), nullptr);
+}
+
+TEST(StaticHashLookupTest, SmallSizes) {
+    for (int sz : {2, 3, 7, 8, 9, 15, 16, 17, 100, 127, 128, 500}) {
+        llti::StaticHashLookup<int64_t> table;
+        std::vector<std::pair<int64_t, int64_t>> entries;
+        for (int64_t i = 0; i < sz; ++i) {
+            entries.push_back({i * 10, i});
+        }
+        table.build(std::move(entries));
+
+        for (int64_t i = 0; i < sz; ++i) {
+            auto* val = table.find(i * 10);
+            ASSERT_NE(val, nullptr) << "sz=" << sz << " key=" << i * 10;
+            EXPECT_EQ(*val, i) << "sz=" << sz;
+        }
+        EXPECT_EQ(table.find(sz * 10), nullptr) << "sz=" << sz;
+    }
+}
+
+TEST(StaticHashLookupTest, LargeRandomDatasetAtTargetLoad) {
+    constexpr int N = 200000;
+    std::mt19937_64 rng(12345);
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    entries.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        int64_t key = static_cast<int64_t>(rng());
+        entries.push_back({key, key * 2});
+    }
+
+    llti::StaticHashLookup<int64_t> table;
+    table.build(entries);
+
+    // ~90% of slots used: 16 bytes of key+value per slot / 0.9.
+    EXPECT_LT(table.bytes_per_key(), 16.0 / 0.85);
+    for (const auto& [key, expected] : entries) {
+        auto* val = table.find(key);
+        ASSERT_NE(val, nullptr) << "key=" << key;
+        EXPECT_EQ(*val, expected);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(table.find(static_cast<int64_t>(rng())), nullptr);
+    }
+}
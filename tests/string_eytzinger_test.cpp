@@ -0,0 +1,86 @@
+#include "llti/string_eytzinger_lookup.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+
+using namespace std::string_literals;
+
+TEST(StringEytzingerLookupTest, FindAllInsertedKeys) {
+    llti::StringEytzingerLookup<int64_t> table;
+    std::vector<std::pair<std::string, int64_t>> entries = {
+        {"US0378331005", 1}, {"GB0002634946", 2}, {"AAPL  240119C00190000", 3},
+        {"AAPL  240119P00190000", 4}, {"AAPL  240216C00190000", 5}, {"ACCT-000017", 6}};
+    table.build(entries);
+    for (const auto& [key, value] : entries) {
+        auto* val = table.find(key);
+        ASSERT_NE(val, nullptr) << key;
+        EXPECT_EQ(*val, value);
+    }
+    EXPECT_EQ(table.find("US0378331006"), nullptr);
+    EXPECT_EQ(table.find("AAPL  240119C0019000"), nullptr);   // proper prefix of a key
+    EXPECT_EQ(table.find("AAPL  240119C001900000"), nullptr); // a key is its proper prefix
+    EXPECT_EQ(table.find("AAPL"), nullptr);
+    EXPECT_EQ(table.find(""), nullptr);
+}
+
+TEST(StringEytzingerLookupTest, ShortKeysAndZeroPadding) {
+    // All of these share the padded prefix "AB\0\0\0\0\0\0"; length and
+    // tail have to tell them apart.
+    llti::StringEytzingerLookup<int64_t> table;
+    table.build({{"AB", 1}, {"AB\0"s, 2}, {"AB\0\0\0\0\0\0"s, 3}, {"AB\0\0\0\0\0\0X"s, 4},
+                 {"", 5}, {"A", 6}});
+    EXPECT_EQ(*table.find("AB"), 1);
+    EXPECT_EQ(*table.find("AB\0"s), 2);
+    EXPECT_EQ(*table.find("AB\0\0\0\0\0\0"s), 3);
+    EXPECT_EQ(*table.find("AB\0\0\0\0\0\0X"s), 4);
+    EXPECT_EQ(*table.find(""), 5);
+    EXPECT_EQ(*table.find("A"), 6);
+    EXPECT_EQ(table.find("AB\0\0"s), nullptr);
+    EXPECT_EQ(table.find("AB\0\0\0\0\0\0Y"s), nullptr);
+}
+
+TEST(StringEytzingerLookupTest, TiesPastSixteenBytes) {
+    llti::StringEytzingerLookup<int64_t> table;
+    table.build({{"0123456789ABCDEF", 1}, {"0123456789ABCDEF\0"s, 2}, {"0123456789ABCDEFG", 3},
+                 {"0123456789ABCDEFGH", 4}, {"0123456789ABCDEFGI", 5}});
+    EXPECT_EQ(*table.find("0123456789ABCDEF"), 1);
+    EXPECT_EQ(*table.find("0123456789ABCDEF\0"s), 2);
+    EXPECT_EQ(*table.find("0123456789ABCDEFG"), 3);
+    EXPECT_EQ(*table.find("0123456789ABCDEFGH"), 4);
+    EXPECT_EQ(*table.find("0123456789ABCDEFGI"), 5);
+    EXPECT_EQ(table.find("0123456789ABCDEFGJ"), nullptr);
+    EXPECT_EQ(table.find("0123456789ABCDE"), nullptr);
+}
+
+TEST(StringEytzingerLookupTest, EmptyTable) {
+    llti::StringEytzingerLookup<int64_t> table;
+    table.build({});
+    EXPECT_EQ(table.find("US0378331005"), nullptr);
+}
+
+TEST(StringEytzingerLookupTest, MatchesMapWithSharedStems) {
+    // OCC-style symbols: few roots, so most keys tie on their first 8 bytes.
+    std::mt19937_64 rng(11);
+    const char* roots[] = {"AAPL  ", "MSFT  ", "SPY   ", "Q     "};
+    std::map<std::string, int64_t> reference;
+    while (reference.size() < 20000) {
+        std::string key = roots[rng() % 4];
+        key += std::to_string(240100 + rng() % 40);
+        key += (rng() % 2) ? 'C' : 'P';
+        key += std::to_string(10000000 + rng() % 90000000);
+        reference[key] = static_cast<int64_t>(rng());
+    }
+    llti::StringEytzingerLookup<int64_t> table;
+    table.build({reference.begin(), reference.end()});
+
+    for (const auto& [key, value] : reference) {
+        auto* val = table.find(key);
+        ASSERT_NE(val, nullptr) << key;
+        EXPECT_EQ(*val, value);
+        std::string miss = key;
+        miss.back() = static_cast<char>(miss.back() + 10);  // past '9'; not a digit
+        EXPECT_EQ(table.find(miss), nullptr) << miss;
+        EXPECT_EQ(table.find(key.substr(0, key.size() - 1)), nullptr);
+    }
+}
@@ -0,0 +1,158 @@
+#include "llti/eytzinger_lookup.h"
+#include "llti/sorted_lookup.h"
+#include "llti/static_hash_lookup.h"
+#include "llti/thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(ChaseLevDequeTest, OwnerIsLifoThiefIsFifo) {
+    llti::ChaseLevDeque<int> deque(2);  // forces two grows
+    int items[5] = {0, 1, 2, 3, 4};
+    for (int& i : items) deque.push(&i);
+    EXPECT_EQ(deque.size(), 5u);
+    EXPECT_EQ(deque.steal(), &items[0]);
+    EXPECT_EQ(deque.take(), &items[4]);
+    EXPECT_EQ(deque.steal(), &items[1]);
+    EXPECT_EQ(deque.take(), &items[3]);
+    EXPECT_EQ(deque.take(), &items[2]);
+    EXPECT_EQ(deque.take(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST(ChaseLevDequeTest, ConcurrentStealsTakeEachItemOnce) {
+    constexpr int kItems = 200000;
+    std::vector<int> items(kItems);
+    std::vector<std::atomic<int>> seen(kItems);
+    llti::ChaseLevDeque<int> deque(16);
+    std::atomic<bool> done{false};
+
+    auto mark = [&](int* item) { seen[item - items.data()].fetch_add(1); };
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            while (!done.load()) {
+                if (int* item = deque.steal()) mark(item);
+            }
+            while (int* item = deque.steal()) mark(item);
+        });
+    }
+    // The owner interleaves pushes with takes, racing thieves for the last item.
+    for (int i = 0; i < kItems; ++i) {
+        deque.push(&items[i]);
+        if (i % 3 == 0)
+            if (int* item = deque.take()) mark(item);
+    }
+    while (int* item = deque.take()) mark(item);
+    done.store(true);
+    for (auto& t : thieves) t.join();
+
+    for (int i = 0; i < kItems; ++i) ASSERT_EQ(seen[i].load(), 1) << "item " << i;
+}
+
+TEST(ThreadPoolTest, ParallelForCoversEachIndexOnce) {
+    llti::ThreadPool pool(4, false);
+    EXPECT_EQ(pool.size(), 4u);
+    for (size_t n : {0, 1, 7, 1000, 100003}) {
+        for (size_t grain : {1, 64, 5000}) {
+            std::vector<std::atomic<int>> hits(n);
+            pool.parallel_for(n, grain, [&](size_t begin, size_t end) {
+                EXPECT_LE(end - begin, grain);
+                for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+            });
+            for (size_t i = 0; i < n; ++i) ASSERT_EQ(hits[i].load(), 1) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(ThreadPoolTest, StaticPartitionGivesOneSlicePerParticipant) {
+    llti::ThreadPool pool(3, false);
+    std::atomic<int> calls{0};
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for_static(1000, [&](size_t begin, size_t end) {
+        calls.fetch_add(1);
+        for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+    });
+    EXPECT_EQ(calls.load(), 3);
+    for (auto& h : hits) ASSERT_EQ(h.load(), 1);
+}
+
+TEST(ThreadPoolTest, NestedAndSingleThreadRunInline) {
+    llti::ThreadPool single(1);
+    std::atomic<size_t> total{0};
+    single.parallel_for(100, 10, [&](size_t b, size_t e) { total += e - b; });
+    EXPECT_EQ(total.load(), 100u);
+
+    llti::ThreadPool pool(3, false);
+    total = 0;
+    pool.parallel_for(8, 1, [&](size_t, size_t) {
+        pool.parallel_for(10, 2, [&](size_t b, size_t e) { total += e - b; });
+    });
+    EXPECT_EQ(total.load(), 80u);
+}
+
+TEST(ThreadPoolTest, NestedCallIntoAnotherPoolKeepsOuterInline) {
+    // A task on `outer` that uses `inner` and then `outer` again must still
+    // run the second outer call inline rather than queue behind itself.
+    llti::ThreadPool outer(3, false);
+    llti::ThreadPool inner(2, false);
+    std::atomic<size_t> total{0};
+    outer.parallel_for(12, 1, [&](size_t, size_t) {
+        inner.parallel_for(10, 2, [&](size_t b, size_t e) { total += e - b; });
+        outer.parallel_for(10, 2, [&](size_t b, size_t e) { total += e - b; });
+    });
+    EXPECT_EQ(total.load(), 240u);
+}
+
+TEST(ThreadPoolTest, ManyBackToBackCalls) {
+    llti::ThreadPool pool(4, false);
+    for (int round = 0; round < 500; ++round) {
+        std::atomic<size_t> sum{0};
+        pool.parallel_for(257, 16, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) sum += i;
+        });
+        ASSERT_EQ(sum.load(), 257u * 256 / 2) << "round " << round;
+    }
+}
+
+TEST(ThreadPoolTest, AlternatingStaticAndDynamicCalls) {
+    // A worker still finishing a dynamic call must not run the next static
+    // call's slice twice.
+    llti::ThreadPool pool(4, false);
+    for (int round = 0; round < 2000; ++round) {
+        std::atomic<size_t> sum{0};
+        auto add = [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) sum += i;
+        };
+        if (round % 2)
+            pool.parallel_for_static(101, add);
+        else
+            pool.parallel_for(101, 8, add);
+        ASSERT_EQ(sum.load(), 101u * 100 / 2) << "round " << round;
+    }
+}
+
+template <class Table>
+static void expect_parallel_find_matches(llti::ThreadPool& pool) {
+    std::mt19937_64 rng(21);
+    std::vector<std::pair<int64_t, int64_t>> entries(50000);
+    for (auto& [k, v] : entries) k = v = static_cast<int64_t>(rng() >> 1);
+    Table table;
+    table.build(entries);
+
+    std::vector<int64_t> queries;
+    for (size_t i = 0; i < 20000; ++i)
+        queries.push_back(entries[rng() % entries.size()].first + static_cast<int64_t>(i & 1));
+    std::vector<const int64_t*> out(queries.size());
+    llti::parallel_find(pool, table, queries.data(), queries.size(), out.data(), 512);
+    for (size_t q = 0; q < queries.size(); ++q) ASSERT_EQ(out[q], table.find(queries[q]));
+}
+
+TEST(ThreadPoolTest, ParallelFindMatchesFind) {
+    llti::ThreadPool pool(4, false);
+    expect_parallel_find_matches<llti::SortedLookup<int64_t>>(pool);
+    expect_parallel_find_matches<llti::EytzingerLookup<int64_t>>(pool);
+    expect_parallel_find_matches<llti::StaticHashLookup<int64_t>>(pool);
+}
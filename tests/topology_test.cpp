@@ -0,0 +1,136 @@
+#include "fake_sysfs.h"
+#include "llti/topology.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+
+// One CPU of the fake host: 48K L1d, 32K L1i and 2M L2 shared with its SMT
+// siblings, and a 105M L3 shared with l3_shared.
+void add_cpu(FakeSysfs& f, int cpu, int core, const std::string& siblings,
+             const std::string& l3_shared) {
+    std::string dir = "sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    f.write(dir + "/topology/physical_package_id", "0");
+    f.write(dir + "/topology/core_id", std::to_string(core));
+    f.write(dir + "/topology/thread_siblings_list", siblings);
+    f.write(dir + "/cache/index0/level", "1");
+    f.write(dir + "/cache/index0/type", "Data");
+    f.write(dir + "/cache/index0/size", "48K");
+    f.write(dir + "/cache/index0/shared_cpu_list", siblings);
+    f.write(dir + "/cache/index1/level", "1");
+    f.write(dir + "/cache/index1/type", "Instruction");
+    f.write(dir + "/cache/index1/size", "32K");
+    f.write(dir + "/cache/index1/shared_cpu_list", siblings);
+    f.write(dir + "/cache/index2/level", "2");
+    f.write(dir + "/cache/index2/type", "Unified");
+    f.write(dir + "/cache/index2/size", "2048K");
+    f.write(dir + "/cache/index2/shared_cpu_list", siblings);
+    f.write(dir + "/cache/index3/level", "3");
+    f.write(dir + "/cache/index3/type", "Unified");
+    f.write(dir + "/cache/index3/size", "105M");
+    f.write(dir + "/cache/index3/shared_cpu_list", l3_shared);
+}
+
+// 1 package, 4 cores x 2 SMT threads. CPUs 0-3 are the first threads,
+// 4-7 their siblings (Intel numbering). Cores 0-1 share one L3, cores 2-3
+// another. CPUs 2-3 are isolated.
+void make_two_l3_host(FakeSysfs& f) {
+    f.write("sys/devices/system/cpu/online", "0-7");
+    for (int c = 0; c < 8; ++c) {
+        int core = c % 4;
+        std::string siblings = std::to_string(core) + "," + std::to_string(core + 4);
+        std::string l3 = core < 2 ? "0-1,4-5" : "2-3,6-7";
+        add_cpu(f, c, core, siblings, l3);
+    }
+    f.write("sys/devices/system/node/node0/cpulist", "0-7");
+    f.write("sys/devices/system/cpu/isolated", "2-3");
+    f.write("proc/cmdline", "BOOT_IMAGE=/vmlinuz isolcpus=2-3 nohz_full=2-3,6-7 quiet");
+}
+
+}  // namespace
+
+TEST(TopologyTest, ParseCpuList) {
+    EXPECT_EQ(llti::parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(llti::parse_cpu_list("5"), (std::vector<int>{5}));
+    EXPECT_EQ(llti::parse_cpu_list(""), std::vector<int>{});
+    EXPECT_EQ(llti::parse_cpu_list("3,1,3"), (std::vector<int>{1, 3}));
+}
+
+TEST(TopologyTest, ParseCpuListSkipsIsolcpusFlags) {
+    EXPECT_EQ(llti::parse_cpu_list("managed_irq,domain,2-4"), (std::vector<int>{2, 3, 4}));
+}
+
+TEST(TopologyTest, DiscoverFakeHost) {
+    FakeSysfs f("llti_topo");
+    make_two_l3_host(f);
+    auto topo = llti::Topology::discover(f.sys(), f.proc());
+
+    ASSERT_EQ(topo.cpus.size(), 8u);
+    EXPECT_EQ(topo.isolated, (std::vector<int>{2, 3}));
+    // sysfs has no nohz_full file here, so the cmdline value is used.
+    EXPECT_EQ(topo.nohz_full, (std::vector<int>{2, 3, 6, 7}));
+    EXPECT_EQ(topo.l1d_bytes, 48u << 10);
+    EXPECT_EQ(topo.l2_bytes, 2048u << 10);
+    EXPECT_EQ(topo.l3_bytes, 105u << 20);
+
+    const llti::CpuInfo* c6 = topo.cpu(6);
+    ASSERT_NE(c6, nullptr);
+    EXPECT_EQ(c6->core, 2);
+    EXPECT_EQ(c6->numa_node, 0);
+    EXPECT_EQ(c6->l2_domain, 2);
+    EXPECT_EQ(c6->l3_domain, 2);
+    EXPECT_FALSE(c6->isolated);
+    EXPECT_TRUE(c6->nohz_full);
+
+    EXPECT_TRUE(topo.are_siblings(1, 5));
+    EXPECT_FALSE(topo.are_siblings(1, 2));
+    EXPECT_TRUE(topo.shares_l3(0, 5));
+    EXPECT_FALSE(topo.shares_l3(0, 2));
+}
+
+TEST(TopologyTest, PlacePrefersIsolatedNonSiblingSameL3) {
+    FakeSysfs f("llti_topo");
+    make_two_l3_host(f);
+    auto topo = llti::Topology::discover(f.sys(), f.proc());
+
+    auto two = topo.place(2);
+    EXPECT_EQ(two, (std::vector<int>{2, 3}));
+
+    // Only two physical cores per L3: a third pick would need an SMT sibling.
+    auto three = topo.place(3);
+    EXPECT_EQ(three.size(), 2u);
+    for (size_t i = 0; i < three.size(); ++i)
+        for (size_t j = i + 1; j < three.size(); ++j) {
+            EXPECT_FALSE(topo.are_siblings(three[i], three[j]));
+            EXPECT_TRUE(topo.shares_l3(three[i], three[j]));
+        }
+}
+
+TEST(TopologyTest, PlaceAvoidsCpuZeroWithoutIsolation) {
+    FakeSysfs f("llti_topo");
+    f.write("sys/devices/system/cpu/online", "0-3");
+    for (int c = 0; c < 4; ++c) add_cpu(f, c, c, std::to_string(c), "0-3");
+
+    auto topo = llti::Topology::discover(f.sys(), f.proc());
+    EXPECT_TRUE(topo.isolated.empty());
+    EXPECT_EQ(topo.place(1), (std::vector<int>{1}));
+    EXPECT_EQ(topo.place(4), (std::vector<int>{1, 2, 3, 0}));
+
+    auto p = topo.place_pipeline();
+    EXPECT_EQ(p.feed, 1);
+    EXPECT_EQ(p.book, 2);
+    EXPECT_EQ(p.strategy, 3);
+}
+
+TEST(TopologyTest, MissingSysfsIsEmpty) {
+    auto topo = llti::Topology::discover("/nonexistent/sys", "/nonexistent/proc");
+    EXPECT_TRUE(topo.cpus.empty());
+    EXPECT_TRUE(topo.place(1).empty());
+    EXPECT_EQ(topo.place_pipeline().feed, -1);
+}
+
+TEST(TopologyTest, DiscoverLiveHost) {
+    auto topo = llti::Topology::discover();
+    ASSERT_FALSE(topo.cpus.empty());
+    EXPECT_FALSE(topo.place(1).empty());
+}
@@ -0,0 +1,344 @@
+#!/usr/bin/env python3
+"""A/B comparison of Google Benchmark results with a merge verdict.
+
+Run-to-run noise on a shared host is several percent, so a single
+before/after pair cannot resolve the 3-5% changes layout tuning produces.
+This tool collects many repetitions per side and decides per benchmark:
+
+  * outliers: Tukey fences (1.5 IQR) per side; dropped unless --keep-outliers
+  * shift:    ratio of medians B/A with a bootstrap 95% confidence interval
+  * test:     two-sided Mann-Whitney U (normal approximation, tie-corrected)
+  * effect:   Cliff's delta (negligible < 0.147 <= small < 0.33 <= medium
+              < 0.474 <= large)
+
+Verdict per benchmark (lower is better for every metric):
+  faster / slower   p < alpha, CI excludes 1.0 and |shift| >= threshold
+  same              CI lies entirely within +/- threshold
+  inconclusive      anything else (collect more rounds)
+
+Modes:
+  run A_BIN B_BIN     run both binaries interleaved (A B B A A B ...) so
+                      drift (thermal, neighbours) hits both sides equally
+  files A.json B.json compare saved --benchmark_out JSON files; each side
+                      may be a comma-separated list of files
+  variants RUN.json --a=RE --b=RE
+                      compare two benchmarks of the same run, e.g.
+                      --a=BM_Eytzinger --b=BM_Veb (names are matched after
+                      removing the RE, so the remainders must agree)
+  table X.json Y.json ...
+                      medians of any number of runs side by side, relative
+                      to the first (e.g. default / LTO / PGO builds); no
+                      verdict, use `files` for that
+
+Only the standard library is used, so this runs on a fresh c7i instance.
+Exit status is 1 with --fail-on-regression if any benchmark is "slower".
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+TIME_SCALE = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+# ── Loading ──────────────────────────────────────────────────────────
+
+
+def load_samples(paths, metric):
+    """{benchmark name: [samples]} from per-repetition entries of JSON files."""
+    samples = {}
+    for path in paths:
+        with open(path) as f:
+            data = json.load(f)
+        for b in data.get("benchmarks", []):
+            if b.get("run_type", "iteration") != "iteration" or b.get("error_occurred"):
+                continue
+            name = b.get("run_name", b["name"])
+            if metric in ("real_time", "cpu_time"):
+                value = b[metric] * TIME_SCALE[b.get("time_unit", "ns")]
+            elif metric in b:
+                value = float(b[metric])
+            else:
+                continue
+            samples.setdefault(name, []).append(value)
+    return samples
+
+
+def run_interleaved(bin_a, bin_b, args):
+    """Run A and B alternately (ABBA order) and return their sample dicts."""
+    tmp = tempfile.mkdtemp(prefix="bench_compare_")
+    outs = {"A": [], "B": []}
+    bins = {"A": bin_a, "B": bin_b}
+    for rnd in range(args.rounds):
+        order = ("A", "B") if rnd % 2 == 0 else ("B", "A")
+        for side in order:
+            out = os.path.join(tmp, f"{side}_{rnd}.json")
+            cmd = [bins[side], f"--benchmark_out={out}", "--benchmark_out_format=json",
+                   f"--benchmark_repetitions={args.repetitions}",
+                   "--benchmark_report_aggregates_only=false"]
+            if args.filter:
+                cmd.append(f"--benchmark_filter={args.filter}")
+            cmd += args.bench_args
+            print(f"[{rnd + 1}/{args.rounds}] {side}: {' '.join(cmd)}", file=sys.stderr)
+            subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+            if not os.path.exists(out) or os.path.getsize(out) == 0:
+                sys.exit(f"{bins[side]} wrote no results (does --filter match anything?)")
+            outs[side].append(out)
+    if args.keep_json:
+        print(f"raw JSON kept in {tmp}", file=sys.stderr)
+    a = load_samples(outs["A"], args.metric)
+    b = load_samples(outs["B"], args.metric)
+    if not args.keep_json:
+        for paths in outs.values():
+            for p in paths:
+                os.remove(p)
+        os.rmdir(tmp)
+    return a, b
+
+
+# ── Statistics ───────────────────────────────────────────────────────
+
+
+def median(xs):
+    s = sorted(xs)
+    n = len(s)
+    return s[n // 2] if n % 2 else 0.5 * (s[n // 2 - 1] + s[n // 2])
+
+
+def quantile(sorted_xs, q):
+    pos = q * (len(sorted_xs) - 1)
+    lo = math.floor(pos)
+    hi = min(lo + 1, len(sorted_xs) - 1)
+    return sorted_xs[lo] + (sorted_xs[hi] - sorted_xs[lo]) * (pos - lo)
+
+
+def tukey_split(xs):
+    """(kept, outliers) using 1.5 IQR fences."""
+    if len(xs) < 4:
+        return list(xs), []
+    s = sorted(xs)
+    q1, q3 = quantile(s, 0.25), quantile(s, 0.75)
+    lo, hi = q1 - 1.5 * (q3 - q1), q3 + 1.5 * (q3 - q1)
+    kept = [x for x in xs if lo <= x <= hi]
+    return kept, [x for x in xs if x < lo or x > hi]
+
+
+def mann_whitney(a, b):
+    """(U for a, two-sided p) via the tie-corrected normal approximation."""
+    n1, n2 = len(a), len(b)
+    pooled = sorted([(x, 0) for x in a] + [(x, 1) for x in b])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        rank = 0.5 * (i + j) + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+    r1 = sum(r for r, (_, side) in zip(ranks, pooled) if side == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    var = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var <= 0:
+        return u1, 1.0
+    z = (abs(u1 - n1 * n2 / 2.0) - 0.5) / math.sqrt(var)  # continuity correction
+    p = math.erfc(max(z, 0.0) / math.sqrt(2.0))
+    return u1, min(p, 1.0)
+
+
+def cliffs_delta(u_a, n1, n2):
+    """P(b > a) - P(b < a): positive means B is larger (slower)."""
+    return 1.0 - 2.0 * u_a / (n1 * n2)
+
+
+def effect_label(d):
+    d = abs(d)
+    if d < 0.147:
+        return "negligible"
+    if d < 0.33:
+        return "small"
+    if d < 0.474:
+        return "medium"
+    return "large"
+
+
+def bootstrap_ratio_ci(a, b, resamples, seed, level=0.95):
+    """Percentile bootstrap CI for median(b) / median(a)."""
+    rng = random.Random(seed)
+    ratios = []
+    for _ in range(resamples):
+        ma = median([rng.choice(a) for _ in a])
+        mb = median([rng.choice(b) for _ in b])
+        ratios.append(mb / ma if ma else float("inf"))
+    ratios.sort()
+    tail = (1.0 - level) / 2.0
+    return quantile(ratios, tail), quantile(ratios, 1.0 - tail)
+
+
+def compare(name, a, b, args):
+    row = {"name": name}
+    if not args.keep_outliers:
+        a, out_a = tukey_split(a)
+        b, out_b = tukey_split(b)
+        row["outliers"] = len(out_a) + len(out_b)
+    else:
+        row["outliers"] = 0
+    row["n_a"], row["n_b"] = len(a), len(b)
+    if len(a) < 3 or len(b) < 3:
+        row.update(verdict="too few samples", shift=float("nan"), ci=(float("nan"),) * 2,
+                   p=float("nan"), cliff=float("nan"), med_a=float("nan"), med_b=float("nan"))
+        return row
+
+    row["med_a"], row["med_b"] = median(a), median(b)
+    row["shift"] = row["med_b"] / row["med_a"] - 1.0 if row["med_a"] else float("nan")
+    lo, hi = bootstrap_ratio_ci(a, b, args.resamples, args.seed)
+    row["ci"] = (lo - 1.0, hi - 1.0)
+    u, row["p"] = mann_whitney(a, b)
+    row["cliff"] = cliffs_delta(u, len(a), len(b))
+
+    thr = args.threshold
+    significant = row["p"] < args.alpha and (row["ci"][0] > 0 or row["ci"][1] < 0)
+    if significant and abs(row["shift"]) >= thr:
+        row["verdict"] = "slower" if row["shift"] > 0 else "faster"
+    elif -thr < row["ci"][0] and row["ci"][1] < thr:
+        row["verdict"] = "same"
+    else:
+        row["verdict"] = "inconclusive"
+    return row
+
+
+# ── Reporting ────────────────────────────────────────────────────────
+
+
+def print_table(rows, metric):
+    unit = "ns" if metric in ("real_time", "cpu_time") or metric.endswith("_ns") else ""
+    header = (f"{'benchmark':<48} {'A ' + unit:>10} {'B ' + unit:>10} {'shift':>8} "
+              f"{'95% CI':>17} {'p':>8} {'cliff':>6} {'effect':>10} {'n':>7} {'out':>4}  verdict")
+    print(header)
+    print("-" * len(header))
+    for r in rows:
+        if r["verdict"] == "too few samples":
+            print(f"{r['name']:<48} {'':>10} {'':>10} {'':>8} {'':>17} {'':>8} {'':>6} "
+                  f"{'':>10} {r['n_a']:>3}/{r['n_b']:<3} {r['outliers']:>4}  {r['verdict']}")
+            continue
+        ci = f"[{r['ci'][0] * 100:+.1f}, {r['ci'][1] * 100:+.1f}]%"
+        print(f"{r['name']:<48} {r['med_a']:>10.2f} {r['med_b']:>10.2f} "
+              f"{r['shift'] * 100:>+7.2f}% {ci:>17} {r['p']:>8.2g} {r['cliff']:>+6.2f} "
+              f"{effect_label(r['cliff']):>10} {r['n_a']:>3}/{r['n_b']:<3} {r['outliers']:>4}  "
+              f"{r['verdict']}")
+
+
+def print_side_by_side(paths, labels, metric):
+    runs = [load_samples(p.split(","), metric) for p in paths]
+    names = [n for n in runs[0] if all(n in r for r in runs[1:])]
+    if not names:
+        sys.exit("no benchmark appears in every run")
+    width = max(12, max(len(label) for label in labels) + 2)
+    header = f"{'benchmark':<48}" + "".join(f"{label:>{width}}" for label in labels)
+    header += "".join(f"{label + ' %':>{width}}" for label in labels[1:])
+    print(header)
+    print("-" * len(header))
+    for n in names:
+        meds = [median(r[n]) for r in runs]
+        line = f"{n:<48}" + "".join(f"{m:>{width}.2f}" for m in meds)
+        line += "".join(f"{(m / meds[0] - 1.0) * 100:>+{width - 1}.1f}%" if meds[0] else
+                        f"{'':>{width}}" for m in meds[1:])
+        print(line)
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0],
+                                formatter_class=argparse.RawDescriptionHelpFormatter,
+                                epilog=__doc__[__doc__.index("Modes:"):])
+    sub = p.add_subparsers(dest="mode", required=True)
+
+    run = sub.add_parser("run", help="run two binaries interleaved")
+    run.add_argument("bin_a")
+    run.add_argument("bin_b")
+    run.add_argument("--filter", default="", help="--benchmark_filter for both sides")
+    run.add_argument("--rounds", type=int, default=6, help="A/B invocations per side")
+    run.add_argument("--repetitions", type=int, default=5,
+                     help="--benchmark_repetitions per invocation")
+    run.add_argument("--bench-args", default="",
+                     help="extra arguments for both binaries, e.g. "
+                          "'--llti_calibrate=off --benchmark_min_time=0.2'")
+    run.add_argument("--keep-json", action="store_true", help="keep the raw JSON files")
+
+    files = sub.add_parser("files", help="compare saved JSON results")
+    files.add_argument("json_a", help="file or comma-separated files for A")
+    files.add_argument("json_b", help="file or comma-separated files for B")
+
+    var = sub.add_parser("variants", help="compare two benchmarks of one run")
+    var.add_argument("json", help="file or comma-separated files")
+    var.add_argument("--a", required=True, help="regex selecting side A")
+    var.add_argument("--b", required=True, help="regex selecting side B")
+
+    table = sub.add_parser("table", help="medians of several runs side by side")
+    table.add_argument("json", nargs="+", help="one result per column (comma-separated "
+                                                 "files are pooled)")
+    table.add_argument("--labels", help="comma-separated column labels")
+    table.add_argument("--metric", default="real_time")
+
+    for sp in (run, files, var):
+        sp.add_argument("--metric", default="real_time",
+                        help="real_time, cpu_time or a counter such as p99_ns")
+        sp.add_argument("--alpha", type=float, default=0.01)
+        sp.add_argument("--threshold", type=float, default=0.01,
+                        help="smallest relative shift worth reporting (default 1%%)")
+        sp.add_argument("--resamples", type=int, default=2000)
+        sp.add_argument("--seed", type=int, default=1)
+        sp.add_argument("--keep-outliers", action="store_true")
+        sp.add_argument("--fail-on-regression", action="store_true",
+                        help="exit 1 if any benchmark is slower")
+        sp.add_argument("--json-out", help="also write the comparison as JSON")
+    args = p.parse_args()
+
+    if args.mode == "table":
+        labels = args.labels.split(",") if args.labels else [
+            os.path.splitext(os.path.basename(p.split(",")[0]))[0] for p in args.json]
+        if len(labels) != len(args.json):
+            sys.exit("--labels must name every column")
+        print_side_by_side(args.json, labels, args.metric)
+        return
+
+    if args.mode == "run":
+        args.bench_args = args.bench_args.split()
+        a, b = run_interleaved(args.bin_a, args.bin_b, args)
+        pairs = [(n, a[n], b[n]) for n in a if n in b]
+    elif args.mode == "files":
+        a = load_samples(args.json_a.split(","), args.metric)
+        b = load_samples(args.json_b.split(","), args.metric)
+        pairs = [(n, a[n], b[n]) for n in a if n in b]
+    else:
+        s = load_samples(args.json.split(","), args.metric)
+        ra, rb = re.compile(args.a), re.compile(args.b)
+        side_a = {ra.sub("", n, count=1): v for n, v in s.items() if ra.search(n)}
+        side_b = {rb.sub("", n, count=1): v for n, v in s.items() if rb.search(n)}
+        pairs = [(f"{args.a} vs {args.b}: {k}" if k else f"{args.a} vs {args.b}",
+                  side_a[k], side_b[k]) for k in side_a if k in side_b]
+
+    if not pairs:
+        sys.exit("no benchmarks with samples on both sides (check --metric / filters)")
+
+    rows = [compare(name, sa, sb, args) for name, sa, sb in pairs]
+    print_table(rows, args.metric)
+    if args.json_out:
+        with open(args.json_out, "w") as f:
+            json.dump(rows, f, indent=2)
+    if args.fail_on_regression and any(r["verdict"] == "slower" for r in rows):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,61 @@
+#include "llti/external_builder.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+
+// Command-line front end for llti::build_eytzinger_file over
+// Record<int64_t> files; also the child process BM_ExternalBuild times.
+//
+//   llti_external_build input.rec output.eyt [--budget_mb=N] [--temp_dir=DIR]
+//
+// Prints the build stats and peak_rss_kb, the VmHWM of this process. A
+// freshly exec'd image starts with its own address space, so unlike the
+// ru_maxrss a parent gets from wait4 (which keeps the peak from before
+// exec) it counts only the build's own pages.
+
+static uint64_t peak_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.rfind("VmHWM:", 0) == 0) return std::strtoull(line.c_str() + 6, nullptr, 10);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string paths[2];
+    int npaths = 0;
+    llti::ExternalBuildOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--budget_mb=", 12) == 0) {
+            options.memory_budget = std::strtoull(argv[i] + 12, nullptr, 10) << 20;
+        } else if (std::strncmp(argv[i], "--temp_dir=", 11) == 0) {
+            options.temp_dir = argv[i] + 11;
+        } else if (npaths < 2) {
+            paths[npaths++] = argv[i];
+        } else {
+            npaths = 3;
+        }
+    }
+    if (npaths != 2) {
+        std::fprintf(stderr,
+                     "usage: %s input output [--budget_mb=N] [--temp_dir=DIR]\n", argv[0]);
+        return 1;
+    }
+
+    try {
+        auto stats = llti::build_eytzinger_file<int64_t>(paths[0], paths[1], options);
+        std::printf("records %llu\nruns %zu\nbytes_read %llu\nbytes_written %llu\n",
+                    static_cast<unsigned long long>(stats.records), stats.runs,
+                    static_cast<unsigned long long>(stats.bytes_read),
+                    static_cast<unsigned long long>(stats.bytes_written));
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "llti_external_build: %s\n", e.what());
+        return 1;
+    }
+    std::printf("peak_rss_kb %llu\n", static_cast<unsigned long long>(peak_rss_kb()));
+    return 0;
+}
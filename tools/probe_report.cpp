@@ -0,0 +1,73 @@
+#include "llti/probe.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Offline reader for llti::probe::dump() output.
+//
+//   llti_probe_report llti_probes.txt
+//   llti_probe_report llti_probes.txt --span=BookAddBegin,BookCancelEnd
+//
+// Pairs probes into per-transaction spans (by default every <X>Begin /
+// <X>End pair) and prints latency percentiles in nanoseconds, converted
+// with the tsc_hz recorded in the dump header. When the dump was built
+// with LLTI_PROBES_PMC the mean counter delta per span is printed too.
+
+int main(int argc, char** argv) {
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--span=", 7) == 0) {
+            std::string spec = argv[i] + 7;
+            auto comma = spec.find(',');
+            if (comma == std::string::npos) {
+                std::fprintf(stderr, "bad --span=%s (want Begin,End)\n", spec.c_str());
+                return 1;
+            }
+            pairs.emplace_back(spec.substr(0, comma), spec.substr(comma + 1));
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: %s <probe dump> [--span=Begin,End ...]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    llti::probe::Dump dump = llti::probe::read_dump(in);
+    if (dump.tsc_hz <= 0.0) {
+        std::fprintf(stderr, "%s: missing tsc_hz header\n", path.c_str());
+        return 1;
+    }
+    const double ns_per_tick = 1e9 / dump.tsc_hz;
+
+    std::printf("%-24s %10s %9s %9s %9s %9s %9s %9s %10s\n", "span", "count", "min_ns",
+                "p50_ns", "p90_ns", "p99_ns", "p999_ns", "max_ns", "pmc_mean");
+    for (auto& span : llti::probe::reconstruct_spans(dump, pairs)) {
+        size_t n = span.ticks.size();
+        if (n == 0) {
+            std::printf("%-24s %10d\n", span.name.c_str(), 0);
+            continue;
+        }
+        std::sort(span.ticks.begin(), span.ticks.end());
+        auto pct = [&](double p) {
+            return span.ticks[std::min(n - 1, static_cast<size_t>(p * n))] * ns_per_tick;
+        };
+        double pmc_sum = 0.0;
+        for (uint64_t v : span.pmc) pmc_sum += static_cast<double>(v);
+        std::printf("%-24s %10zu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %10.1f\n",
+                    span.name.c_str(), n, span.ticks.front() * ns_per_tick, pct(0.50),
+                    pct(0.90), pct(0.99), pct(0.999), span.ticks.back() * ns_per_tick,
+                    pmc_sum / n);
+    }
+    return 0;
+}